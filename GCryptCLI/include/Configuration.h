@@ -39,6 +39,11 @@ class Configuration {
       GENERATE_KEY
     } activeModule;
 
+    static enum class CIPHER_MODE {
+      CBC,
+      COUNTER
+    } cipherMode;
+
     //! Will analyze the supplied cli parameters,
     //! and decide what the configuration will be.
     static void Parse();
@@ -49,6 +54,7 @@ class Configuration {
     static void DecideCiphertextFormat();
     static void MapCiphertextFormatToIOBases();
     static void DecideModule();
+    static void DecideCipherMode();
 
     // This is just an intermediary value, used between methods
     static IOBASE_FORMAT ciphertextFormat;
@@ -38,6 +38,10 @@ namespace IO {
       //! Returns how many blocks have been read, in total
       static std::size_t NBlocksRead();
 
+      //! Returns how many bytes the blocks read hold, in total.
+      //! For cleartext, a last short block only counts the bytes actually read.
+      static std::size_t NBytesRead();
+
     private:
       static std::istream* in;
 
@@ -63,6 +67,9 @@ namespace IO {
       // How many blocks have been read in total
       static std::size_t nBlocksRead;
 
+      // How many bytes the blocks read hold in total
+      static std::size_t nBytesRead;
+
       // All read blocks, that haven't been given out yet
       static std::queue<Block> blocks;
 
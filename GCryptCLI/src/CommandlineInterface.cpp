@@ -95,6 +95,10 @@ void CommandlineInterface::Init(int argc, const char* const* argv) {
   nupp.RegisterDescription("--iobase-ugh", "Interpret and format ciphertexts in base ugh");
   nupp.RegisterConstraint("--iobase-ugh", ParamConstraint(true, DATA_TYPE::VOID, {}, false, { "--iobase-bytes", "--iobase-2", "--iobase-8", "--iobase-10", "--iobase-16", "--iobase-64", "--iobase-uwu" }));
 
+  nupp.RegisterDescription("--counter-mode", "Chain blocks in counter mode, instead of cipher block chaining. Data encrypted in counter mode has to be decrypted in counter mode.");
+  nupp.RegisterConstraint("--counter-mode", ParamConstraint(true, DATA_TYPE::VOID, {}, false, { "--hash", "--generate-key" }));
+  nupp.RegisterAbbreviation("-cm", "--counter-mode");
+
   nupp.RegisterDescription("--lib-version", "Will supply the version of GCryptLib used.");
   nupp.RegisterConstraint("--lib-version", ParamConstraint(true, DATA_TYPE::VOID, {}, false, {}));
 
@@ -3,6 +3,7 @@
 
 void Configuration::Parse() {
   DecideModule();
+  DecideCipherMode();
   DecideInputFrom();
   DecideOutputTo();
   DecideCiphertextFormat();
@@ -34,6 +35,17 @@ void Configuration::DecideModule() {
   return;
 }
 
+void Configuration::DecideCipherMode() {
+  if (CommandlineInterface::Get().HasParam("--counter-mode")) {
+    cipherMode = CIPHER_MODE::COUNTER;
+  }
+  else {
+    cipherMode = CIPHER_MODE::CBC;
+  }
+
+  return;
+}
+
 void Configuration::DecideInputFrom() {
 
   if (CommandlineInterface::Get().HasParam("--intext")) {
@@ -178,6 +190,7 @@ void Configuration::MapCiphertextFormatToIOBases() {
 std::string Configuration::inputFilename;
 std::string Configuration::outputFilename;
 Configuration::MODULE Configuration::activeModule;
+Configuration::CIPHER_MODE Configuration::cipherMode;
 Configuration::IOBASE_FORMAT Configuration::formatIn;
 Configuration::IOBASE_FORMAT Configuration::formatOut;
 Configuration::IOBASE_FORMAT Configuration::ciphertextFormat;
@@ -67,6 +67,7 @@ void DataIngestionLayer::Init() {
   initialized = true;
   reachedEof = false;
   nBlocksRead = 0;
+  nBytesRead = 0;
 
   return;
 }
@@ -131,6 +132,7 @@ void DataIngestionLayer::ReadBlock() {
           // When just reading cleartext-bytes, we also allow shorter strings
           // than BLOCK_SIZE. These will just get zero-padded.
           newBlock.FromTextString(dataRead);
+          nBytesRead += n_bytes_read;
         }
         else {
           // Else: recode to a block.
@@ -138,6 +140,7 @@ void DataIngestionLayer::ReadBlock() {
             dataRead,
             Configuration::formatIn
           );
+          nBytesRead += Block::BLOCK_SIZE;
         }
 
         blocks.emplace(newBlock);
@@ -248,6 +251,7 @@ void DataIngestionLayer::ReadBlock() {
                 // Enqueue it to be processed by some module
                 blocks.emplace(newBlock);
                 nBlocksRead++;
+                nBytesRead += Block::BLOCK_SIZE;
                 foundBlock = true;
 
                 // Now we have to calculate how many bytes we've read TOO MANY.
@@ -356,6 +360,10 @@ std::size_t DataIngestionLayer::NBlocksRead() {
   return nBlocksRead;
 }
 
+std::size_t DataIngestionLayer::NBytesRead() {
+  return nBytesRead;
+}
+
 std::istream* DataIngestionLayer::in;
 std::ifstream DataIngestionLayer::ifs;
 std::istringstream DataIngestionLayer::iss;
@@ -363,5 +371,6 @@ bool DataIngestionLayer::reachedEof = false;
 bool DataIngestionLayer::initialized = false;
 bool DataIngestionLayer::isReadingCiphertext;
 std::size_t DataIngestionLayer::nBlocksRead = 0;
+std::size_t DataIngestionLayer::nBytesRead = 0;
 std::queue<Block> DataIngestionLayer::blocks;
 
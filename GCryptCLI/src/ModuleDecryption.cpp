@@ -3,7 +3,9 @@
 #include "DataOutputLayer.h"
 #include "ProgressPrinter.h"
 #include "KeyManager.h"
+#include "Configuration.h"
 #include <GCrypt/GCipher.h>
+#include <GCrypt/GCounterCipher.h>
 
 using namespace Module;
 using namespace Leonetienne::GCrypt;
@@ -16,11 +18,19 @@ void Decryption::Run() {
   // Initialize the data output layer
   IO::DataOutputLayer::Init();
 
-  // Initialize a cipher
-  GCipher cipher(
-    KeyManager::GetKey(),
-    GCipher::DIRECTION::DECIPHER
-  );
+  // Initialize a cipher, in the chosen mode
+  GCipher cipher;
+  GCounterCipher counterCipher;
+  const bool counterMode = Configuration::cipherMode == Configuration::CIPHER_MODE::COUNTER;
+  bool haveNonce = false;
+
+  // In counter mode, the cipher gets initialized once the leading nonce has been read
+  if (!counterMode) {
+    cipher.Initialize(
+      KeyManager::GetKey(),
+      GCipher::DIRECTION::DECIPHER
+    );
+  }
 
   std::size_t nBlocksDigested = 0;
   while (!IO::DataOutputLayer::IsFinished()) {
@@ -40,11 +50,21 @@ void Decryption::Run() {
       );
 
       const Block cleartext = IO::DataIngestionLayer::GetNextBlock();
-      const Block ciphertext = cipher.Digest(cleartext);
-      nBlocksDigested++;
 
-      // Enqueue the block for output
-      IO::DataOutputLayer::Enqueue(ciphertext);
+      // The first block of counter mode ciphertext is its nonce
+      if ((counterMode) && (!haveNonce)) {
+        counterCipher.Initialize(KeyManager::GetKey(), cleartext);
+        haveNonce = true;
+      }
+      else {
+        const Block ciphertext = counterMode ?
+          counterCipher.Digest(cleartext) :
+          cipher.Digest(cleartext);
+        nBlocksDigested++;
+
+        // Enqueue the block for output
+        IO::DataOutputLayer::Enqueue(ciphertext);
+      }
     }
 
     // Tell the data output layer that it received the
@@ -3,7 +3,9 @@
 #include "DataOutputLayer.h"
 #include "KeyManager.h"
 #include "ProgressPrinter.h"
+#include "Configuration.h"
 #include <GCrypt/GCipher.h>
+#include <GCrypt/GCounterCipher.h>
 #include <iostream>
 
 using namespace Module;
@@ -17,11 +19,23 @@ void Encryption::Run() {
   // Initialize the data output layer
   IO::DataOutputLayer::Init();
 
-  // Initialize a cipher
-  GCipher cipher(
-    KeyManager::GetKey(),
-    GCipher::DIRECTION::ENCIPHER
-  );
+  // Initialize a cipher, in the chosen mode
+  GCipher cipher;
+  GCounterCipher counterCipher;
+  const bool counterMode = Configuration::cipherMode == Configuration::CIPHER_MODE::COUNTER;
+
+  if (counterMode) {
+    // Every encryption gets a fresh nonce, which leads the ciphertext
+    const Block nonce = Key::Random();
+    counterCipher.Initialize(KeyManager::GetKey(), nonce);
+    IO::DataOutputLayer::Enqueue(nonce);
+  }
+  else {
+    cipher.Initialize(
+      KeyManager::GetKey(),
+      GCipher::DIRECTION::ENCIPHER
+    );
+  }
 
   std::size_t nBlocksDigested = 0;
   while (!IO::DataOutputLayer::IsFinished()) {
@@ -41,7 +55,9 @@ void Encryption::Run() {
       );
 
       const Block cleartext = IO::DataIngestionLayer::GetNextBlock();
-      const Block ciphertext = cipher.Digest(cleartext);
+      const Block ciphertext = counterMode ?
+        counterCipher.Digest(cleartext) :
+        cipher.Digest(cleartext);
       nBlocksDigested++;
 
       // Enqueue the block for output
@@ -42,6 +42,10 @@ void Hashing::Run() {
     }
   }
 
+  // Terminate the hash with the size of the input, just like GHash::CalculateHashsum() does.
+  // Without it, inputs that only differ in trailing nullbytes would hash the same.
+  hasher.Digest(GHash::LengthBlock(IO::DataIngestionLayer::NBytesRead()));
+
   // Wait until we've finished digesting all blocks
   // Enqueue that single block (the hash result) to the output layer
   IO::DataOutputLayer::Enqueue(hasher.GetHashsum());
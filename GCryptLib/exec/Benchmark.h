@@ -1,9 +1,16 @@
 #ifndef GCRYPTEXAMPLE_BENCHMARK_H
 #define GCRYPTEXAMPLE_BENCHMARK_H
 
+#include <algorithm>
 #include <functional>
 #include <chrono>
 #include <iostream>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#ifdef __linux__
+#include <sched.h>
+#endif
 
 void Benchmark(const std::string& brief, std::function<void()> toBenchmark) {
   std::cout << "Benchmarking " << brief << "..." << std::endl;
@@ -19,5 +26,75 @@ void Benchmark(const std::string& brief, std::function<void()> toBenchmark) {
   return;
 }
 
+//! Will run toBenchmark n times, and print the average amount of time and cpu cycles per run.
+//! Cycles are read from the time stamp counter, so they are reference cycles.
+template <typename Func>
+void BenchmarkCycles(const std::string& brief, const std::size_t n, Func toBenchmark) {
+  std::cout << "Benchmarking " << brief << "..." << std::endl;
+
+  auto start = std::chrono::steady_clock::now();
+#if defined(__x86_64__) || defined(__i386__)
+  const unsigned long long startCycles = __rdtsc();
+#endif
+
+  for (std::size_t i = 0; i < n; i++) {
+    toBenchmark();
+  }
+
+#if defined(__x86_64__) || defined(__i386__)
+  const unsigned long long endCycles = __rdtsc();
+#endif
+  auto end = std::chrono::steady_clock::now();
+
+  const double nanoseconds = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / n;
+  std::cout << nanoseconds << " ns";
+#if defined(__x86_64__) || defined(__i386__)
+  std::cout << ", " << (double)(endCycles - startCycles) / n << " cycles";
+#endif
+  std::cout << " per run." << std::endl << std::endl;
+
+  return;
+}
+
+//! Will pin the calling thread to one core, so that it does not migrate while being benchmarked.
+//! Only does anything on linux. Returns whether it worked.
+bool PinToCore(const int core) {
+#ifdef __linux__
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+  CPU_SET(core, &cpuSet);
+
+  return sched_setaffinity(0, sizeof(cpuSet), &cpuSet) == 0;
+#else
+  return false;
+#endif
+}
+
+//! Will run toBenchmark n times, each run digesting nBytes, and print the best amount of cpu cycles per byte.
+//! Taking the best run filters out interrupts and other noise.
+//! Cycles are read from the time stamp counter, so they are reference cycles.
+template <typename Func>
+void BenchmarkCyclesPerByte(const std::string& brief, const std::size_t nBytes, const std::size_t n, Func toBenchmark) {
+  std::cout << "Benchmarking " << brief << "..." << std::endl;
+
+#if defined(__x86_64__) || defined(__i386__)
+  unsigned long long bestCycles = ~0ull;
+
+  for (std::size_t i = 0; i < n; i++) {
+    const unsigned long long startCycles = __rdtsc();
+    toBenchmark();
+    const unsigned long long endCycles = __rdtsc();
+
+    bestCycles = std::min(bestCycles, endCycles - startCycles);
+  }
+
+  std::cout << (double)bestCycles / nBytes << " cycles per byte." << std::endl << std::endl;
+#else
+  std::cout << "No time stamp counter on this platform." << std::endl << std::endl;
+#endif
+
+  return;
+}
+
 #endif
 
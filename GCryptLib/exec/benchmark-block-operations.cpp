@@ -0,0 +1,90 @@
+#include <GCrypt/Block.h>
+#include <GCrypt/Key.h>
+#include <GCrypt/Util.h>
+#include <iostream>
+#include "Benchmark.h"
+
+using namespace Leonetienne::GCrypt;
+
+// The bitshift, as it used to be implemented (copy, shift, then carry via Mod()).
+// Kept around as a baseline, to see what the funnel-shift kernels save.
+template <typename T>
+void LegacyShiftBitsLeftInplace(Basic_Block<T>& block) {
+  const Basic_Block<T> tmp = block;
+
+  for (std::size_t i = 0; i < 16; i++) {
+    block[i] <<= 1;
+  }
+
+  constexpr std::size_t bitmaskMsb = 1 << (Basic_Block<T>::CHUNK_SIZE_BITS - 1);
+  constexpr std::size_t bitmaskLsb = 1;
+  for (int i = 0; i < 16; i++) {
+    const bool msb = tmp[i] & bitmaskMsb;
+
+    if (msb) {
+      block[Mod(i-1, 16)] |= bitmaskLsb;
+    }
+    else {
+      block[Mod(i-1, 16)] &= ~bitmaskLsb;
+    }
+  }
+
+  return;
+}
+
+template <typename T>
+void LegacyShiftBitsRightInplace(Basic_Block<T>& block) {
+  const Basic_Block<T> tmp = block;
+
+  for (std::size_t i = 0; i < 16; i++) {
+    block[i] >>= 1;
+  }
+
+  constexpr std::size_t bitmaskMsb = 1 << (Basic_Block<T>::CHUNK_SIZE_BITS - 1);
+  constexpr std::size_t bitmaskLsb = 1;
+  for (int i = 0; i < 16; i++) {
+    const bool lsb = tmp[i] & bitmaskLsb;
+
+    if (lsb) {
+      block[Mod(i+1, 16)] |= bitmaskMsb;
+    }
+    else {
+      block[Mod(i+1, 16)] &= ~bitmaskMsb;
+    }
+  }
+
+  return;
+}
+
+int main() {
+  constexpr std::size_t n = 1000000;
+
+  Block block = Key::Random();
+  Halfblock halfblock;
+  for (std::size_t i = 0; i < 16; i++) {
+    halfblock[i] = block[i];
+  }
+
+  BenchmarkCycles("Block::ShiftBitsLeftInplace() (legacy)", n, [&block]() { LegacyShiftBitsLeftInplace(block); });
+  BenchmarkCycles("Block::ShiftBitsLeftInplace()", n, [&block]() { block.ShiftBitsLeftInplace(); });
+  BenchmarkCycles("Block::ShiftBitsRightInplace() (legacy)", n, [&block]() { LegacyShiftBitsRightInplace(block); });
+  BenchmarkCycles("Block::ShiftBitsRightInplace()", n, [&block]() { block.ShiftBitsRightInplace(); });
+
+  BenchmarkCycles("Halfblock::ShiftBitsLeftInplace() (legacy)", n, [&halfblock]() { LegacyShiftBitsLeftInplace(halfblock); });
+  BenchmarkCycles("Halfblock::ShiftBitsLeftInplace()", n, [&halfblock]() { halfblock.ShiftBitsLeftInplace(); });
+  BenchmarkCycles("Halfblock::ShiftBitsRightInplace() (legacy)", n, [&halfblock]() { LegacyShiftBitsRightInplace(halfblock); });
+  BenchmarkCycles("Halfblock::ShiftBitsRightInplace()", n, [&halfblock]() { halfblock.ShiftBitsRightInplace(); });
+
+  BenchmarkCycles("Block::ShiftRowsUpInplace()", n, [&block]() { block.ShiftRowsUpInplace(); });
+  BenchmarkCycles("Block::ShiftCellsRightInplace()", n, [&block]() { block.ShiftCellsRightInplace(); });
+  BenchmarkCycles("Halfblock::ShiftRowsUpInplace()", n, [&halfblock]() { halfblock.ShiftRowsUpInplace(); });
+  BenchmarkCycles("Halfblock::ShiftCellsRightInplace()", n, [&halfblock]() { halfblock.ShiftCellsRightInplace(); });
+
+  constexpr BlockPermutation composed = BlockPermutation::ShiftRowsUp().Then(BlockPermutation::ShiftCellsRight());
+  BenchmarkCycles("Block::PermuteInplace() (rows up, then cells right)", n, [&block, &composed]() { block.PermuteInplace(composed); });
+
+  // Print the blocks, so that none of the above gets optimized out
+  std::cout << block.ToHexString() << std::endl << halfblock.ToHexString() << std::endl;
+
+  return 0;
+}
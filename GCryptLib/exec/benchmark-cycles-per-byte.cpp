@@ -0,0 +1,116 @@
+#include <GCrypt/GCipher.h>
+#include <GCrypt/GHash.h>
+#include <GCrypt/Feistel.h>
+#include <GCrypt/InitializationVector.h>
+#include <iostream>
+#include <vector>
+#include "Benchmark.h"
+
+using namespace Leonetienne::GCrypt;
+
+// How many blocks each benchmark run digests (64 KiB)
+constexpr std::size_t N_BLOCKS = 1024;
+constexpr std::size_t N_BYTES = N_BLOCKS * Block::BLOCK_SIZE;
+constexpr std::size_t N_RUNS = 50;
+
+// Will encipher blocks in CBC mode, running the rounds of each block first,
+// and rolling the keyset for the next one only afterwards.
+// This is how a stream digested blocks before the key schedule got woven into the rounds.
+void EncipherSequentially(std::vector<Block>& blocks, const Key& key) {
+  Keyset keyset;
+  Feistel::GenerateKeyset(keyset, key);
+
+  Block lastBlock = InitializationVector(key);
+  for (Block& block : blocks) {
+    block = Feistel::Encipher(block ^ lastBlock, keyset);
+    lastBlock = block;
+
+    Feistel::RollKeyset(keyset);
+  }
+
+  return;
+}
+
+int main() {
+  // Cycle counts are only meaningful if the thread stays on one core
+  if (!PinToCore(0)) {
+    std::cout << "Unable to pin this thread to a core. Cycle counts may be off." << std::endl << std::endl;
+  }
+
+  const Key key = Key::FromPassword("password1");
+  const std::vector<Block> cleartext(N_BLOCKS, Key::FromPassword("cleartext"));
+  std::vector<Block> blocks;
+
+  BenchmarkCyclesPerByte(
+    "encryption, rounds first, key schedule afterwards",
+    N_BYTES, N_RUNS,
+    [&]() {
+      blocks = cleartext;
+      EncipherSequentially(blocks, key);
+    }
+  );
+
+  BenchmarkCyclesPerByte(
+    "encryption, key schedule woven into the rounds (GCipher)",
+    N_BYTES, N_RUNS,
+    [&]() {
+      GCipher cipher(key, GCipher::DIRECTION::ENCIPHER);
+      blocks = cleartext;
+      for (Block& block : blocks) {
+        block = cipher.Digest(block);
+      }
+    }
+  );
+
+  std::vector<Block> ciphertext = cleartext;
+  GCipher(key, GCipher::DIRECTION::ENCIPHER).DigestInplace(ciphertext);
+
+  BenchmarkCyclesPerByte(
+    "decryption, one block at a time (GCipher)",
+    N_BYTES, N_RUNS,
+    [&]() {
+      GCipher cipher(key, GCipher::DIRECTION::DECIPHER);
+      blocks = ciphertext;
+      for (Block& block : blocks) {
+        block = cipher.Digest(block);
+      }
+    }
+  );
+
+  BenchmarkCyclesPerByte(
+    "decryption, runs of blocks side by side (GCipher)",
+    N_BYTES, N_RUNS,
+    [&]() {
+      GCipher cipher(key, GCipher::DIRECTION::DECIPHER);
+      blocks = ciphertext;
+      cipher.DigestInplace(blocks);
+    }
+  );
+
+  Block hashsum;
+
+  BenchmarkCyclesPerByte(
+    "hashing, one block at a time (GHash::Digest)",
+    N_BYTES, N_RUNS,
+    [&]() {
+      GHash hasher;
+      for (const Block& block : cleartext) {
+        hasher.Digest(block);
+      }
+      hashsum = hasher.GetHashsum();
+    }
+  );
+
+  BenchmarkCyclesPerByte(
+    "hashing, keysets generated alongside the block before (GHash::CalculateHashsum)",
+    N_BYTES, N_RUNS,
+    [&]() { hashsum = GHash::CalculateHashsum(cleartext); }
+  );
+
+  // Print a block, so that none of the above gets optimized out
+  std::cout << hashsum.ToHexString().substr(0, 16) << std::endl;
+
+  std::cout << blocks.back().ToHexString().substr(0, 16) << std::endl;
+
+  return 0;
+}
@@ -1,8 +1,127 @@
 #include <GCrypt/GWrapper.h>
+#include <GCrypt/GCipher.h>
+#include <GCrypt/BasicGCipher.h>
+#include <GCrypt/HashingCipher.h>
+#include <GCrypt/GCounterCipher.h>
+#include <GCrypt/MultiBufferCipher.h>
 #include "Benchmark.h"
 
 using namespace Leonetienne::GCrypt;
 
+// Will encipher n blocks in a row, with the given key schedule
+void EncipherBlocks(const std::size_t n, const GCipher::KEY_SCHEDULE keySchedule) {
+  GCipher cipher(Key::FromPassword("password1"), GCipher::DIRECTION::ENCIPHER, keySchedule);
+
+  const Block cleartext = Key::FromPassword("cleartext");
+  Block ciphertext;
+  for (std::size_t i = 0; i < n; i++) {
+    ciphertext = cipher.Digest(cleartext);
+  }
+
+  // Print the last block, so that none of the above gets optimized out
+  std::cout << ciphertext.ToHexString().substr(0, 16) << std::endl;
+
+  return;
+}
+
+// Will encipher n blocks in a row, with direction and mode fixed at compile time
+void EncipherBlocksBasic(const std::size_t n) {
+  BasicGCipher<CipherModes::CBC, CIPHER_DIRECTION::ENCIPHER> cipher(Key::FromPassword("password1"));
+
+  const Block cleartext = Key::FromPassword("cleartext");
+  Block ciphertext;
+  for (std::size_t i = 0; i < n; i++) {
+    ciphertext = cipher.Digest(cleartext);
+  }
+
+  // Print the last block, so that none of the above gets optimized out
+  std::cout << ciphertext.ToHexString().substr(0, 16) << std::endl;
+
+  return;
+}
+
+// Will decipher n blocks in a row, either one by one, or in runs side by side
+void DecipherBlocks(const std::size_t n, const bool sideBySide) {
+  GCipher cipher(Key::FromPassword("password1"), GCipher::DIRECTION::DECIPHER);
+
+  std::vector<Block> blocks(n, Key::FromPassword("ciphertext"));
+  if (sideBySide) {
+    cipher.DigestInplace(blocks);
+  }
+  else {
+    for (Block& block : blocks) {
+      block = cipher.Digest(block);
+    }
+  }
+
+  // Print the last block, so that none of the above gets optimized out
+  std::cout << blocks.back().ToHexString().substr(0, 16) << std::endl;
+
+  return;
+}
+
+// Will encipher n blocks, spread over Lanes independent streams that advance side by side
+template <std::size_t Lanes>
+void EncipherBlocksMultiBuffer(const std::size_t n) {
+  MultiBufferCipher<Lanes> cipher(GCipher::DIRECTION::ENCIPHER);
+  for (std::size_t i = 0; i < Lanes; i++) {
+    cipher.Initialize(i, Key::FromPassword("password" + std::to_string(i)));
+  }
+
+  const Block cleartext = Key::FromPassword("cleartext");
+  std::array<Block, Lanes> blocks;
+  for (std::size_t i = 0; i < n / Lanes; i++) {
+    blocks.fill(cleartext);
+    cipher.Digest(blocks);
+  }
+
+  // Print the last block, so that none of the above gets optimized out
+  std::cout << blocks.back().ToHexString().substr(0, 16) << std::endl;
+
+  return;
+}
+
+// Will encipher n blocks in counter mode, on all cores
+void EncipherBlocksCounter(const std::size_t n) {
+  GCounterCipher cipher(Key::FromPassword("password1"), Key::Random());
+
+  std::vector<Block> blocks(n, Key::FromPassword("cleartext"));
+  cipher.DigestInplace(blocks);
+
+  // Print the last block, so that none of the above gets optimized out
+  std::cout << blocks.back().ToHexString().substr(0, 16) << std::endl;
+
+  return;
+}
+
+// Will encipher n blocks, and hash the ciphertext afterwards, in two passes
+void EncipherThenHashBlocks(const std::size_t n) {
+  const std::vector<Block> cleartext(n, Key::FromPassword("cleartext"));
+  const std::vector<Block> ciphertext = GWrapper::CipherBlocks(cleartext, Key::FromPassword("password1"), GCipher::DIRECTION::ENCIPHER);
+  const Block hashsum = GHash::CalculateHashsum(ciphertext);
+
+  // Print the hashsum, so that none of the above gets optimized out
+  std::cout << hashsum.ToHexString().substr(0, 16) << std::endl;
+
+  return;
+}
+
+// Will encipher n blocks, and hash the ciphertext on the side, in one pass
+void EncipherAndHashBlocks(const std::size_t n) {
+  HashingCipher cipher(Key::FromPassword("password1"), GCipher::DIRECTION::ENCIPHER);
+
+  const Block cleartext = Key::FromPassword("cleartext");
+  for (std::size_t i = 0; i < n; i++) {
+    cipher.Digest(cleartext);
+  }
+  const Block hashsum = cipher.Finish();
+
+  // Print the hashsum, so that none of the above gets optimized out
+  std::cout << hashsum.ToHexString().substr(0, 16) << std::endl;
+
+  return;
+}
+
 int main() {
 
   Benchmark(
@@ -16,6 +135,71 @@ int main() {
     }
   );
 
+  Benchmark(
+    "file decryption (parallel)",
+    []() {
+      GWrapper::DecryptFile(
+        "./execAssets/testimage.bmp.crypt",
+        "./execAssets/testimage.bmp.decrypt.bmp",
+        Key::FromPassword("password1")
+      );
+    }
+  );
+
+  Benchmark(
+    "block encryption, inline key schedule",
+    []() { EncipherBlocks(100000, GCipher::KEY_SCHEDULE::INLINE); }
+  );
+
+  Benchmark(
+    "block encryption, lookahead key schedule",
+    []() { EncipherBlocks(100000, GCipher::KEY_SCHEDULE::LOOKAHEAD); }
+  );
+
+  Benchmark(
+    "block encryption, compile-time mode (BasicGCipher)",
+    []() { EncipherBlocksBasic(100000); }
+  );
+
+  Benchmark(
+    "block decryption, one block at a time",
+    []() { DecipherBlocks(100000, false); }
+  );
+
+  Benchmark(
+    "block decryption, runs of blocks side by side",
+    []() { DecipherBlocks(100000, true); }
+  );
+
+  Benchmark(
+    "block encryption, 4 streams side by side (MultiBufferCipher)",
+    []() { EncipherBlocksMultiBuffer<4>(100000); }
+  );
+
+  Benchmark(
+    "block encryption, 8 streams side by side (MultiBufferCipher)",
+    []() { EncipherBlocksMultiBuffer<8>(100000); }
+  );
+
+  Benchmark(
+    "block encryption, 16 streams side by side (MultiBufferCipher)",
+    []() { EncipherBlocksMultiBuffer<16>(100000); }
+  );
+
+  Benchmark(
+    "block encryption, counter mode",
+    []() { EncipherBlocksCounter(100000); }
+  );
+
+  Benchmark(
+    "block encryption, then hashing the ciphertext",
+    []() { EncipherThenHashBlocks(20000); }
+  );
+
+  Benchmark(
+    "block encryption, hashing the ciphertext on the side",
+    []() { EncipherAndHashBlocks(20000); }
+  );
+
   return 0;
 }
-
@@ -0,0 +1,107 @@
+#include <GCrypt/FeistelKernels.h>
+#include <GCrypt/Block.h>
+#include <GCrypt/Key.h>
+#include <GCrypt/SBoxLookup.h>
+#include <iostream>
+#include "Benchmark.h"
+
+using namespace Leonetienne::GCrypt;
+
+// The stages of the feistel function, as they used to be chained from block operations.
+// Every stage materializes a new block. Kept around as a baseline, to see what the fused kernel saves.
+Block LegacyExpansion(const Halfblock& hb) {
+  Block b;
+  for (std::size_t i = 0; i < 16; i++) {
+    b[i] = hb[i];
+  }
+
+  for (std::size_t i = 0; i < 3; i++) {
+    b *= b.ShiftBitsRight();
+  }
+
+  return b;
+}
+
+Halfblock LegacyReduction(const Block& block) {
+  Halfblock hb;
+  for (std::size_t i = 0; i < 16; i++) {
+    hb[i] = block[i] % (1 << (Halfblock::CHUNK_SIZE_BITS - 1));
+  }
+
+  return hb;
+}
+
+void LegacySBox(Block& block) {
+  std::uint8_t* bytes = (std::uint8_t*)(void*)block.Data();
+  for (std::size_t i = 1; i < Block::BLOCK_SIZE; i++) {
+    bytes[i] = sboxLookup[bytes[i]];
+  }
+
+  return;
+}
+
+Halfblock LegacyF(Halfblock m, const Key& key) {
+  Block m_expanded = LegacyExpansion(m);
+  m_expanded.ShiftCellsRightInplace();
+  m_expanded.ShiftRowsUpInplace();
+  m_expanded *= key;
+  m_expanded.ShiftBitsLeftInplace();
+  LegacySBox(m_expanded);
+
+  Halfblock hb = LegacyReduction(m_expanded);
+  hb *= m;
+
+  return hb;
+}
+
+int main() {
+  constexpr std::size_t n = 1000000;
+
+  const Key key = Key::Random();
+  Block block = Key::Random();
+  Halfblock halfblock;
+  for (std::size_t i = 0; i < 16; i++) {
+    halfblock[i] = block[i];
+  }
+
+  // Each stage feeds its result back into its input, so that no run can get optimized out
+  BenchmarkCycles("Expansion (legacy)", n, [&block, &halfblock]() {
+    block = LegacyExpansion(halfblock);
+    halfblock[0] ^= block[0];
+  });
+  BenchmarkCycles("Expansion (kernel)", n, [&block, &halfblock]() {
+    Kernels::Expand(block.Data(), halfblock.Data());
+    halfblock[0] ^= block[0];
+  });
+
+  BenchmarkCycles("Mixing permutation (legacy)", n, [&block]() {
+    block.ShiftCellsRightInplace();
+    block.ShiftRowsUpInplace();
+  });
+  BenchmarkCycles("Mixing permutation (kernel)", n, [&block]() {
+    Kernels::PermuteCells(block.Data(), block.Data(), Kernels::F_MIXING_PERMUTATION.Data());
+  });
+
+  BenchmarkCycles("Key multiplication (legacy)", n, [&block, &key]() { block *= key; });
+  BenchmarkCycles("Key multiplication (kernel)", n, [&block, &key]() { Kernels::MMul(block.Data(), block.Data(), key.Data()); });
+
+  BenchmarkCycles("SBox (legacy)", n, [&block]() { LegacySBox(block); });
+  BenchmarkCycles("SBox (kernel)", n, [&block]() { Kernels::SBox((std::uint8_t*)(void*)block.Data()); });
+
+  BenchmarkCycles("Reduction (legacy)", n, [&block, &halfblock]() {
+    halfblock = LegacyReduction(block);
+    block[0] ^= halfblock[0];
+  });
+  BenchmarkCycles("Reduction (kernel)", n, [&block, &halfblock]() {
+    Kernels::Reduce(halfblock.Data(), block.Data());
+    block[0] ^= halfblock[0];
+  });
+
+  BenchmarkCycles("F (legacy)", n, [&halfblock, &key]() { halfblock = LegacyF(halfblock, key); });
+  BenchmarkCycles("F (fused kernel)", n, [&halfblock, &key]() { Kernels::F(halfblock.Data(), halfblock.Data(), key.Data()); });
+
+  // Print the blocks, so that none of the above gets optimized out
+  std::cout << block.ToHexString() << std::endl << halfblock.ToHexString() << std::endl;
+
+  return 0;
+}
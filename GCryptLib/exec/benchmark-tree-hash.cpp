@@ -0,0 +1,38 @@
+#include <GCrypt/GHash.h>
+#include <GCrypt/GTreeHash.h>
+#include <iostream>
+#include <thread>
+#include "Benchmark.h"
+
+using namespace Leonetienne::GCrypt;
+
+// How many bytes each benchmark hashes (64 MiB, 256 leaves)
+constexpr std::size_t N_BYTES = 64 * 1024 * 1024;
+
+int main() {
+  const std::string input(N_BYTES, 'a');
+  Block hashsum;
+
+  Benchmark(
+    "hashing 64 MiB with GHash (one serial chain)",
+    [&]() {
+      GHash hasher;
+      hasher.Update(input);
+      hashsum = hasher.Finalize();
+    }
+  );
+
+  // Double the threads up to the number of hardware threads, and once more, to show where it stops scaling
+  const std::size_t nHardwareThreads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+  for (std::size_t nThreads = 1; nThreads <= nHardwareThreads * 2; nThreads *= 2) {
+    Benchmark(
+      "hashing 64 MiB with GTreeHash on " + std::to_string(nThreads) + " thread(s), of " + std::to_string(nHardwareThreads) + " hardware thread(s)",
+      [&]() { hashsum = GTreeHash::CalculateHashsum(input, nThreads); }
+    );
+  }
+
+  // Print the last hashsum, so that none of the above gets optimized out
+  std::cout << hashsum.ToHexString().substr(0, 16) << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,163 @@
+#ifndef GCRYPT_BASICGCIPHER_H
+#define GCRYPT_BASICGCIPHER_H
+
+#include "GCrypt/Feistel.h"
+#include "GCrypt/Config.h"
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace Leonetienne::GCrypt {
+  //! Describes the direction a cipher runs in
+  enum class CIPHER_DIRECTION {
+    ENCIPHER,
+    DECIPHER
+  };
+
+  /** Modes of operation, to plug into BasicGCipher.
+  * A mode owns the state of a stream, and digests one block at a time in a direction known at compile time.
+  * Explicitly instantiated for N_ROUNDS.
+  */
+  namespace CipherModes {
+    /** Cipher block chaining.
+    * Every cleartext block gets xored with the previous ciphertext block (the initialization vector, for the first one).
+    * The keyset rolls after every block.
+    */
+    template <std::size_t Rounds>
+    class CBC {
+    public:
+      //! Empty initializer. If you use this, you must call Initialize()!
+      CBC();
+
+      //! Will start a new stream with a key
+      void Initialize(const Key& key);
+
+      //! Will swap the key, without restarting the chaining
+      void SetKey(const Key& key);
+
+      //! Will digest a block, using and rolling the own keyset
+      template <CIPHER_DIRECTION Direction>
+      Block Digest(const Block& input);
+
+      //! Will digest a block, using a keyset computed elsewhere (see KeysetLookahead).
+      //! Only does the chaining. The own keyset does not roll.
+      template <CIPHER_DIRECTION Direction>
+      Block Digest(const Block& input, const BasicKeyset<Rounds>& keyset);
+
+      //! Will decipher Lanes consecutive blocks in place, block i with keysets[i], in one lane-parallel pass.
+      //! Each cleartext block only needs its own keyset and the ciphertext block before it,
+      //! so the blocks can go through the feistel rounds side by side (see BasicFeistel::DecipherLanes()).
+      //! Only does the chaining. The own keyset does not roll.
+      //! Explicitly instantiated for 4, 8 and 16 lanes.
+      template <std::size_t Lanes>
+      void Decipher(Block* blocks, const BasicKeyset<Rounds>* const* keysets);
+
+      //! Will decipher n consecutive blocks in place, using and rolling the own keyset.
+      //! Yields exactly what n calls to Digest() in DECIPHER direction yield,
+      //! but deciphers runs of DECIPHER_LANES blocks in one lane-parallel pass,
+      //! rolling the keysets of each run while the run before it deciphers.
+      void DecipherInplace(Block* blocks, const std::size_t n);
+
+      //! How many consecutive blocks DecipherInplace() deciphers side by side
+      static constexpr std::size_t DECIPHER_LANES = 4;
+
+      //! Will return the state the next block starts from: the keyset it will use, and the last ciphertext block
+      void ExportState(BasicKeyset<Rounds>& nextKeyset, Block& lastBlock) const;
+
+      //! Will continue a stream from an exported state
+      void ImportState(const BasicKeyset<Rounds>& nextKeyset, const Block& lastBlock);
+
+    private:
+      //! Will do what Decipher() does, and roll the keysets of the next Lanes blocks into nextKeysets on the side
+      //! (see BasicFeistel::DecipherLanesAndRoll()). Without nextKeysets, nothing gets rolled.
+      template <std::size_t Lanes>
+      void DecipherAndRoll(Block* blocks, const BasicKeyset<Rounds>* const* keysets, BasicKeyset<Rounds>* const* nextKeysets);
+
+      BasicFeistel<Rounds> feistel;
+
+      //! The last ciphertext block
+      Block lastBlock;
+    };
+
+    /** Counter mode.
+    * Keystream block i is the encipherment of (nonce || i), under a stream key derived from the key.
+    * It gets xored into data block i, so both directions are the same operation.
+    * There is no nonce derived from the key: every message needs a nonce of its own, supplied by the caller.
+    */
+    template <std::size_t Rounds>
+    class Counter {
+    public:
+      //! Empty initializer. If you use this, you must call Initialize()!
+      Counter();
+
+      ~Counter();
+
+      //! Will start a new stream with a key, and a nonce
+      void Initialize(const Key& key, const Block& nonce);
+
+      //! Will digest the next block
+      template <CIPHER_DIRECTION Direction>
+      Block Digest(const Block& input);
+
+      //! Will return keystream block i
+      Block KeystreamBlock(const std::size_t i) const;
+
+      //! Will make the next digested block the one at blockIndex
+      void Seek(const std::size_t blockIndex);
+
+      //! Will return the index of the next block to be digested
+      std::size_t GetPosition() const;
+
+    private:
+      //! The keyset of the stream key. It does not roll, so that every block can get enciphered on its own.
+      BasicKeyset<Rounds> keyset;
+
+      Block nonce;
+
+      //! The index of the next block to be digested
+      std::size_t position = 0;
+    };
+  }
+
+  /** A cipher with its mode of operation, direction, and number of feistel rounds fixed at compile time.
+  * Digest() has no dispatch of its own, and DigestInplace() lives next to the mode,
+  * so hot loops run without any per-block branching or indirect calls.
+  * Which block kernels (SIMD or scalar) get used is fixed at compile time anyway, see Config.h.
+  *
+  * GCipher wraps this for CBC, picking the direction and key schedule at runtime.
+  * Explicitly instantiated for CBC and Counter, both directions, and N_ROUNDS.
+  */
+  template <template <std::size_t> class Mode, CIPHER_DIRECTION Direction, std::size_t Rounds = N_ROUNDS>
+  class BasicGCipher {
+  public:
+    //! Will initialize this cipher with a key.
+    //! Counter mode needs a nonce as well, so it only has the constructor below.
+    template <typename M = Mode<Rounds>, typename = std::enable_if_t<!std::is_same_v<M, CipherModes::Counter<Rounds>>>>
+    explicit BasicGCipher(const Key& key);
+
+    //! Will initialize this cipher with a key, and a nonce. Counter mode only.
+    template <typename M = Mode<Rounds>, typename = std::enable_if_t<std::is_same_v<M, CipherModes::Counter<Rounds>>>>
+    BasicGCipher(const Key& key, const Block& nonce);
+
+    // Disable copying
+    BasicGCipher(const BasicGCipher& other) = delete;
+    BasicGCipher(BasicGCipher&& other) noexcept = delete;
+
+    //! Will digest a data block, and return it
+    Block Digest(const Block& input);
+
+    //! Will digest n data blocks in place
+    void DigestInplace(Block* blocks, const std::size_t n);
+
+    //! Will digest data blocks in place
+    void DigestInplace(std::vector<Block>& blocks);
+
+    //! Will return the mode, for anything specific to it (like Counter::Seek())
+    Mode<Rounds>& GetMode();
+
+  private:
+    Mode<Rounds> mode;
+  };
+}
+
+#endif
@@ -9,6 +9,76 @@
 
 namespace Leonetienne::GCrypt {
 
+  /** This class represents a fixed permutation of the 16 cells of a block.
+  *   It applies to full blocks and half blocks alike.
+  *   Consecutive permutations can be composed into a single one, which then gets applied in one go.
+  */
+  class BlockPermutation {
+    public:
+      //! Will construct the identity permutation
+      constexpr BlockPermutation() :
+        table { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 } {
+      }
+
+      //! Will construct a permutation from a table.
+      //! Cell i of the permuted block will be cell table[i] of the input block.
+      constexpr explicit BlockPermutation(const std::array<std::uint8_t, 16>& table) :
+        table { table } {
+      }
+
+      //! Will return a permutation that equals applying this permutation first, and then `next`
+      [[nodiscard]] constexpr BlockPermutation Then(const BlockPermutation& next) const {
+        std::array<std::uint8_t, 16> composed {};
+        for (std::size_t i = 0; i < 16; i++) {
+          composed[i] = table[next.table[i]];
+        }
+        return BlockPermutation(composed);
+      }
+
+      //! Returns the index of the input cell that ends up in cell `index`
+      [[nodiscard]] constexpr std::uint8_t operator[](const std::uint8_t index) const {
+        return table[index];
+      }
+
+      //! Will return a pointer to the table
+      [[nodiscard]] constexpr const std::uint8_t* Data() const noexcept {
+        return table.data();
+      }
+
+      //! Shifts matrix rows upwards by 1
+      [[nodiscard]] static constexpr BlockPermutation ShiftRowsUp() {
+        return BlockPermutation({ 1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12 });
+      }
+
+      //! Shifts matrix rows downwards by 1
+      [[nodiscard]] static constexpr BlockPermutation ShiftRowsDown() {
+        return BlockPermutation({ 3, 0, 1, 2, 7, 4, 5, 6, 11, 8, 9, 10, 15, 12, 13, 14 });
+      }
+
+      //! Shifts matrix columns to the left by 1
+      [[nodiscard]] static constexpr BlockPermutation ShiftColumnsLeft() {
+        return BlockPermutation({ 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3 });
+      }
+
+      //! Shifts matrix columns to the right by 1
+      [[nodiscard]] static constexpr BlockPermutation ShiftColumnsRight() {
+        return BlockPermutation({ 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 });
+      }
+
+      //! Shifts array cells to the left by 1
+      [[nodiscard]] static constexpr BlockPermutation ShiftCellsLeft() {
+        return BlockPermutation({ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 0 });
+      }
+
+      //! Shifts array cells to the right by 1
+      [[nodiscard]] static constexpr BlockPermutation ShiftCellsRight() {
+        return BlockPermutation({ 15, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14 });
+      }
+
+    private:
+      std::array<std::uint8_t, 16> table;
+  };
+
   /** This class represents a block of data,
   *   and provides functions to manipulate it
   */
@@ -67,6 +137,11 @@ namespace Leonetienne::GCrypt {
       void MMulInplace(const Basic_Block<T>& other);
       Basic_Block<T>& operator*=(const Basic_Block<T>& other);
 
+      //! Will matrix-multiply two blocks together, always using the portable scalar implementation.
+      //! MMul() and MMulInplace() will use a vectorized kernel instead, if the target supports one.
+      //! Both yield bit-identical results.
+      [[nodiscard]] Basic_Block<T> MMulScalar(const Basic_Block<T>& other) const;
+
       //! Will xor two blocks together
       [[nodiscard]] Basic_Block<T> Xor(const Basic_Block<T>& other) const;
       //! Will xor two blocks together
@@ -97,6 +172,13 @@ namespace Leonetienne::GCrypt {
       //! Will subtract all the integer making up this block, one by one, inplace
       Basic_Block<T>& operator-=(const Basic_Block<T>& other);
 
+      //! Will permute the cells of this block.
+      //! All the row-, column-, and cell shifts are such permutations.
+      [[nodiscard]] Basic_Block<T> Permute(const BlockPermutation& permutation) const;
+
+      //! Will permute the cells of this block, inplace
+      void PermuteInplace(const BlockPermutation& permutation);
+
       //! Will shift rows upwards by 1
       [[nodiscard]] Basic_Block<T> ShiftRowsUp() const;
 
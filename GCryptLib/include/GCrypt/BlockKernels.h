@@ -0,0 +1,502 @@
+#ifndef GCRYPT_BLOCKKERNELS_H
+#define GCRYPT_BLOCKKERNELS_H
+
+#include <cstdint>
+#include <cstring>
+#include "GCrypt/Config.h"
+
+#ifdef GCRYPT_INTRINSICS_SSE41
+#include <immintrin.h>
+#endif
+
+// The compute kernels behind Basic_Block, working on plain arrays of 16 cells.
+// This header is internal to GCrypt. What the kernels compile to depends on the
+// instruction set of the including translation unit, which is why they have internal linkage.
+namespace Leonetienne::GCrypt::Kernels {
+  namespace {
+#ifdef GCRYPT_INTRINSICS_SSE41
+    // Matrix-multiplies two column-major 4x4 uint32 matrices: out = a * b.
+    // Column c of the product is the sum over k of column k of a,
+    // times the broadcasted element b(k, c).
+    // All operands get loaded before anything gets stored, so out may alias a or b.
+    inline void MMulKernel(std::uint32_t* out, const std::uint32_t* a, const std::uint32_t* b) {
+#ifdef GCRYPT_INTRINSICS_AVX2
+      // Each ymm register holds two columns. Duplicate the columns of a into both lanes,
+      // so that two columns of the product can be computed at once.
+      const __m256i a0 = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(a + 0)));
+      const __m256i a1 = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(a + 4)));
+      const __m256i a2 = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(a + 8)));
+      const __m256i a3 = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(a + 12)));
+
+      const __m256i b01 = _mm256_loadu_si256((const __m256i*)(b + 0));
+      const __m256i b23 = _mm256_loadu_si256((const __m256i*)(b + 8));
+
+      // The in-lane shuffle broadcasts b(k, c) and b(k, c+1) into their respective lanes
+      const __m256i m01 = _mm256_add_epi32(
+        _mm256_add_epi32(
+          _mm256_mullo_epi32(a0, _mm256_shuffle_epi32(b01, 0x00)),
+          _mm256_mullo_epi32(a1, _mm256_shuffle_epi32(b01, 0x55))
+        ),
+        _mm256_add_epi32(
+          _mm256_mullo_epi32(a2, _mm256_shuffle_epi32(b01, 0xAA)),
+          _mm256_mullo_epi32(a3, _mm256_shuffle_epi32(b01, 0xFF))
+        )
+      );
+
+      const __m256i m23 = _mm256_add_epi32(
+        _mm256_add_epi32(
+          _mm256_mullo_epi32(a0, _mm256_shuffle_epi32(b23, 0x00)),
+          _mm256_mullo_epi32(a1, _mm256_shuffle_epi32(b23, 0x55))
+        ),
+        _mm256_add_epi32(
+          _mm256_mullo_epi32(a2, _mm256_shuffle_epi32(b23, 0xAA)),
+          _mm256_mullo_epi32(a3, _mm256_shuffle_epi32(b23, 0xFF))
+        )
+      );
+
+      _mm256_storeu_si256((__m256i*)(out + 0), m01);
+      _mm256_storeu_si256((__m256i*)(out + 8), m23);
+#else
+      __m128i ac[4];
+      __m128i bc[4];
+      for (std::size_t i = 0; i < 4; i++) {
+        ac[i] = _mm_loadu_si128((const __m128i*)(a + i*4));
+        bc[i] = _mm_loadu_si128((const __m128i*)(b + i*4));
+      }
+
+      for (std::size_t c = 0; c < 4; c++) {
+        const __m128i m = _mm_add_epi32(
+          _mm_add_epi32(
+            _mm_mullo_epi32(ac[0], _mm_shuffle_epi32(bc[c], 0x00)),
+            _mm_mullo_epi32(ac[1], _mm_shuffle_epi32(bc[c], 0x55))
+          ),
+          _mm_add_epi32(
+            _mm_mullo_epi32(ac[2], _mm_shuffle_epi32(bc[c], 0xAA)),
+            _mm_mullo_epi32(ac[3], _mm_shuffle_epi32(bc[c], 0xFF))
+          )
+        );
+
+        _mm_storeu_si128((__m128i*)(out + c*4), m);
+      }
+#endif
+      return;
+    }
+
+    // Matrix-multiplies two column-major 4x4 uint16 matrices: out = a * b.
+    // A column is 64 bits wide, so a 64-bit broadcast repeats one column of a
+    // for every column of the product. The byte shuffle broadcasts b(k, c)
+    // across the 64 bits of column c.
+    // All operands get loaded before anything gets stored, so out may alias a or b.
+    inline void MMulKernel(std::uint16_t* out, const std::uint16_t* a, const std::uint16_t* b) {
+      std::int64_t ac[4];
+      memcpy(ac, a, sizeof(ac));
+
+#ifdef GCRYPT_INTRINSICS_AVX2
+      // The whole matrix fits into a single register
+      const __m256i bv = _mm256_loadu_si256((const __m256i*)b);
+
+      __m256i m = _mm256_setzero_si256();
+      for (int k = 0; k < 4; k++) {
+        const __m256i broadcastMask = _mm256_setr_epi8(
+          2*k, 2*k+1, 2*k, 2*k+1, 2*k, 2*k+1, 2*k, 2*k+1,
+          2*k+8, 2*k+9, 2*k+8, 2*k+9, 2*k+8, 2*k+9, 2*k+8, 2*k+9,
+          2*k, 2*k+1, 2*k, 2*k+1, 2*k, 2*k+1, 2*k, 2*k+1,
+          2*k+8, 2*k+9, 2*k+8, 2*k+9, 2*k+8, 2*k+9, 2*k+8, 2*k+9
+        );
+
+        m = _mm256_add_epi16(m, _mm256_mullo_epi16(
+          _mm256_set1_epi64x(ac[k]),
+          _mm256_shuffle_epi8(bv, broadcastMask)
+        ));
+      }
+
+      _mm256_storeu_si256((__m256i*)out, m);
+#else
+      // Every register holds two columns
+      const __m128i b01 = _mm_loadu_si128((const __m128i*)(b + 0));
+      const __m128i b23 = _mm_loadu_si128((const __m128i*)(b + 8));
+
+      __m128i m01 = _mm_setzero_si128();
+      __m128i m23 = _mm_setzero_si128();
+      for (int k = 0; k < 4; k++) {
+        const __m128i broadcastMask = _mm_setr_epi8(
+          2*k, 2*k+1, 2*k, 2*k+1, 2*k, 2*k+1, 2*k, 2*k+1,
+          2*k+8, 2*k+9, 2*k+8, 2*k+9, 2*k+8, 2*k+9, 2*k+8, 2*k+9
+        );
+        const __m128i ak = _mm_set1_epi64x(ac[k]);
+
+        m01 = _mm_add_epi16(m01, _mm_mullo_epi16(ak, _mm_shuffle_epi8(b01, broadcastMask)));
+        m23 = _mm_add_epi16(m23, _mm_mullo_epi16(ak, _mm_shuffle_epi8(b23, broadcastMask)));
+      }
+
+      _mm_storeu_si128((__m128i*)(out + 0), m01);
+      _mm_storeu_si128((__m128i*)(out + 8), m23);
+#endif
+      return;
+    }
+
+    // Elementwise operations, in the widest registers available.
+#ifdef GCRYPT_INTRINSICS_AVX2
+    typedef __m256i Vec;
+
+    inline Vec VecLoad(const void* p) { return _mm256_loadu_si256((const __m256i*)p); }
+    inline void VecStore(void* p, const Vec v) { _mm256_storeu_si256((__m256i*)p, v); }
+    inline Vec VecXor(const Vec a, const Vec b) { return _mm256_xor_si256(a, b); }
+    inline Vec VecAdd(const Vec a, const Vec b, std::uint16_t) { return _mm256_add_epi16(a, b); }
+    inline Vec VecAdd(const Vec a, const Vec b, std::uint32_t) { return _mm256_add_epi32(a, b); }
+    inline Vec VecSub(const Vec a, const Vec b, std::uint16_t) { return _mm256_sub_epi16(a, b); }
+    inline Vec VecSub(const Vec a, const Vec b, std::uint32_t) { return _mm256_sub_epi32(a, b); }
+    inline Vec VecOr(const Vec a, const Vec b) { return _mm256_or_si256(a, b); }
+    inline Vec VecShiftLeft(const Vec a, const int n, std::uint16_t) { return _mm256_slli_epi16(a, n); }
+    inline Vec VecShiftLeft(const Vec a, const int n, std::uint32_t) { return _mm256_slli_epi32(a, n); }
+    inline Vec VecShiftRight(const Vec a, const int n, std::uint16_t) { return _mm256_srli_epi16(a, n); }
+    inline Vec VecShiftRight(const Vec a, const int n, std::uint32_t) { return _mm256_srli_epi32(a, n); }
+
+    // Returns the register following a, shifted in by one element of nBytes: {a1, a2, ..., aN, b0}.
+    // The lane-crossing permute lines up the upper half of a with the lower half of b,
+    // so that the in-lane byte alignment can take it from there.
+    template <int nBytes>
+    inline Vec VecNextElements(const Vec a, const Vec b) {
+      return _mm256_alignr_epi8(_mm256_permute2x128_si256(a, b, 0x21), a, nBytes);
+    }
+
+    // Returns the register preceding b, shifted in by one element of nBytes: {aN, b0, ..., bN-1}
+    template <int nBytes>
+    inline Vec VecPreviousElements(const Vec a, const Vec b) {
+      return _mm256_alignr_epi8(b, _mm256_permute2x128_si256(a, b, 0x21), 16 - nBytes);
+    }
+#else
+    typedef __m128i Vec;
+
+    inline Vec VecLoad(const void* p) { return _mm_loadu_si128((const __m128i*)p); }
+    inline void VecStore(void* p, const Vec v) { _mm_storeu_si128((__m128i*)p, v); }
+    inline Vec VecXor(const Vec a, const Vec b) { return _mm_xor_si128(a, b); }
+    inline Vec VecAdd(const Vec a, const Vec b, std::uint16_t) { return _mm_add_epi16(a, b); }
+    inline Vec VecAdd(const Vec a, const Vec b, std::uint32_t) { return _mm_add_epi32(a, b); }
+    inline Vec VecSub(const Vec a, const Vec b, std::uint16_t) { return _mm_sub_epi16(a, b); }
+    inline Vec VecSub(const Vec a, const Vec b, std::uint32_t) { return _mm_sub_epi32(a, b); }
+    inline Vec VecOr(const Vec a, const Vec b) { return _mm_or_si128(a, b); }
+    inline Vec VecShiftLeft(const Vec a, const int n, std::uint16_t) { return _mm_slli_epi16(a, n); }
+    inline Vec VecShiftLeft(const Vec a, const int n, std::uint32_t) { return _mm_slli_epi32(a, n); }
+    inline Vec VecShiftRight(const Vec a, const int n, std::uint16_t) { return _mm_srli_epi16(a, n); }
+    inline Vec VecShiftRight(const Vec a, const int n, std::uint32_t) { return _mm_srli_epi32(a, n); }
+
+    // Returns the register following a, shifted in by one element of nBytes: {a1, a2, ..., aN, b0}
+    template <int nBytes>
+    inline Vec VecNextElements(const Vec a, const Vec b) {
+      return _mm_alignr_epi8(b, a, nBytes);
+    }
+
+    // Returns the register preceding b, shifted in by one element of nBytes: {aN, b0, ..., bN-1}
+    template <int nBytes>
+    inline Vec VecPreviousElements(const Vec a, const Vec b) {
+      return _mm_alignr_epi8(b, a, 16 - nBytes);
+    }
+#endif
+
+    // Applies op on all registers of a block: out = op(a, b)
+    template <typename T, typename Op>
+    inline void ElementwiseKernel(T* out, const T* a, const T* b, Op op) {
+      constexpr std::size_t nVecs = (sizeof(T) * 16) / sizeof(Vec);
+      constexpr std::size_t elementsPerVec = sizeof(Vec) / sizeof(T);
+
+      for (std::size_t i = 0; i < nVecs; i++) {
+        VecStore(out + i*elementsPerVec, op(
+          VecLoad(a + i*elementsPerVec),
+          VecLoad(b + i*elementsPerVec)
+        ));
+      }
+
+      return;
+    }
+
+    // Rotates all bits of a block to the left by one, as a funnel shift:
+    // out[i] = (in[i] << 1) | (in[i+1] >> (bits-1)), wrapping around at the end.
+    // All registers get loaded before anything gets stored, so out may alias in.
+    template <typename T>
+    inline void RotateBitsLeftKernel(T* out, const T* in) {
+      constexpr std::size_t nVecs = (sizeof(T) * 16) / sizeof(Vec);
+      constexpr std::size_t elementsPerVec = sizeof(Vec) / sizeof(T);
+
+      Vec v[nVecs];
+      for (std::size_t i = 0; i < nVecs; i++) {
+        v[i] = VecLoad(in + i*elementsPerVec);
+      }
+
+      for (std::size_t i = 0; i < nVecs; i++) {
+        const Vec next = VecNextElements<sizeof(T)>(v[i], v[(i + 1) % nVecs]);
+#ifdef GCRYPT_INTRINSICS_AVX512VBMI2
+        if constexpr (sizeof(T) == 2) {
+          VecStore(out + i*elementsPerVec, _mm256_shldi_epi16(v[i], next, 1));
+        }
+        else {
+          VecStore(out + i*elementsPerVec, _mm256_shldi_epi32(v[i], next, 1));
+        }
+#else
+        VecStore(out + i*elementsPerVec, VecOr(
+          VecShiftLeft(v[i], 1, T()),
+          VecShiftRight(next, sizeof(T)*8 - 1, T())
+        ));
+#endif
+      }
+
+      return;
+    }
+
+    // Rotates all bits of a block to the right by one, as a funnel shift:
+    // out[i] = (in[i] >> 1) | (in[i-1] << (bits-1)), wrapping around at the beginning.
+    // All registers get loaded before anything gets stored, so out may alias in.
+    template <typename T>
+    inline void RotateBitsRightKernel(T* out, const T* in) {
+      constexpr std::size_t nVecs = (sizeof(T) * 16) / sizeof(Vec);
+      constexpr std::size_t elementsPerVec = sizeof(Vec) / sizeof(T);
+
+      Vec v[nVecs];
+      for (std::size_t i = 0; i < nVecs; i++) {
+        v[i] = VecLoad(in + i*elementsPerVec);
+      }
+
+      for (std::size_t i = 0; i < nVecs; i++) {
+        const Vec previous = VecPreviousElements<sizeof(T)>(v[(i + nVecs - 1) % nVecs], v[i]);
+#ifdef GCRYPT_INTRINSICS_AVX512VBMI2
+        if constexpr (sizeof(T) == 2) {
+          VecStore(out + i*elementsPerVec, _mm256_shrdi_epi16(v[i], previous, 1));
+        }
+        else {
+          VecStore(out + i*elementsPerVec, _mm256_shrdi_epi32(v[i], previous, 1));
+        }
+#else
+        VecStore(out + i*elementsPerVec, VecOr(
+          VecShiftRight(v[i], 1, T()),
+          VecShiftLeft(previous, sizeof(T)*8 - 1, T())
+        ));
+#endif
+      }
+
+      return;
+    }
+#endif
+
+#ifdef GCRYPT_INTRINSICS_AVX512VBMI2
+    // A full-sized block fits into a single zmm register.
+    // valignd rotates it by one element, and vpshldd/vpshrdd funnel the bits over.
+    inline void RotateBitsLeftKernel(std::uint32_t* out, const std::uint32_t* in) {
+      const __m512i v = _mm512_loadu_si512(in);
+      _mm512_storeu_si512(out, _mm512_shldi_epi32(v, _mm512_alignr_epi32(v, v, 1), 1));
+      return;
+    }
+
+    inline void RotateBitsRightKernel(std::uint32_t* out, const std::uint32_t* in) {
+      const __m512i v = _mm512_loadu_si512(in);
+      _mm512_storeu_si512(out, _mm512_shrdi_epi32(v, _mm512_alignr_epi32(v, v, 15), 1));
+      return;
+    }
+#endif
+
+    // Permutes the cells of a block: out[i] = in[table[i]].
+    // This is the portable version. The overloads below replace it with register shuffles, where available.
+    // out may alias in.
+    template <typename T>
+    inline void PermuteCells(T* out, const T* in, const std::uint8_t* table) {
+      T tmp[16];
+      memcpy(tmp, in, sizeof(tmp));
+
+      for (std::size_t i = 0; i < 16; i++) {
+        out[i] = tmp[table[i]];
+      }
+
+      return;
+    }
+
+#ifdef GCRYPT_INTRINSICS_AVX2
+    inline void PermuteCells(std::uint32_t* out, const std::uint32_t* in, const std::uint8_t* table) {
+#ifdef GCRYPT_INTRINSICS_AVX512
+      // A single vpermd over all 16 cells
+      const __m512i indices = _mm512_cvtepu8_epi32(_mm_loadu_si128((const __m128i*)table));
+      _mm512_storeu_si512(out, _mm512_permutexvar_epi32(indices, _mm512_loadu_si512(in)));
+#else
+      const __m256i lo = _mm256_loadu_si256((const __m256i*)(in + 0));
+      const __m256i hi = _mm256_loadu_si256((const __m256i*)(in + 8));
+      const __m256i indicesLo = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(table + 0)));
+      const __m256i indicesHi = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(table + 8)));
+
+      // vpermd only regards the lower three bits of an index.
+      // The fourth bit decides which of both registers to take the cell from.
+      const __m256i seven = _mm256_set1_epi32(7);
+      const __m256i outLo = _mm256_blendv_epi8(
+        _mm256_permutevar8x32_epi32(lo, indicesLo),
+        _mm256_permutevar8x32_epi32(hi, indicesLo),
+        _mm256_cmpgt_epi32(indicesLo, seven)
+      );
+      const __m256i outHi = _mm256_blendv_epi8(
+        _mm256_permutevar8x32_epi32(lo, indicesHi),
+        _mm256_permutevar8x32_epi32(hi, indicesHi),
+        _mm256_cmpgt_epi32(indicesHi, seven)
+      );
+
+      _mm256_storeu_si256((__m256i*)(out + 0), outLo);
+      _mm256_storeu_si256((__m256i*)(out + 8), outHi);
+#endif
+      return;
+    }
+#endif
+
+#ifdef GCRYPT_INTRINSICS_SSE41
+    inline void PermuteCells(std::uint16_t* out, const std::uint16_t* in, const std::uint8_t* table) {
+#ifdef GCRYPT_INTRINSICS_AVX512
+      // A single vpermw over all 16 cells
+      const __m256i indices = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)table));
+      _mm256_storeu_si256((__m256i*)out, _mm256_permutexvar_epi16(indices, _mm256_loadu_si256((const __m256i*)in)));
+#else
+      const __m128i lo = _mm_loadu_si128((const __m128i*)(in + 0));
+      const __m128i hi = _mm_loadu_si128((const __m128i*)(in + 8));
+
+      // Translate cell indices to pairs of byte indices: (2*i) | (2*i+1) << 8
+      const __m128i toBytes = _mm_set1_epi16(0x0202);
+      const __m128i highByte = _mm_set1_epi16(0x0100);
+      const __m128i bytesLo = _mm_add_epi16(_mm_mullo_epi16(_mm_cvtepu8_epi16(_mm_loadl_epi64((const __m128i*)(table + 0))), toBytes), highByte);
+      const __m128i bytesHi = _mm_add_epi16(_mm_mullo_epi16(_mm_cvtepu8_epi16(_mm_loadl_epi64((const __m128i*)(table + 8))), toBytes), highByte);
+
+      // pshufb only regards the lower four bits of a byte index, and zeroes bytes with the msb set.
+      // So shuffle both source registers, with the bytes of the respective other one masked out.
+      const __m128i fifteen = _mm_set1_epi8(15);
+      const __m128i sixteen = _mm_set1_epi8(16);
+      const __m128i outLo = _mm_or_si128(
+        _mm_shuffle_epi8(lo, _mm_or_si128(bytesLo, _mm_cmpgt_epi8(bytesLo, fifteen))),
+        _mm_shuffle_epi8(hi, _mm_or_si128(bytesLo, _mm_cmplt_epi8(bytesLo, sixteen)))
+      );
+      const __m128i outHi = _mm_or_si128(
+        _mm_shuffle_epi8(lo, _mm_or_si128(bytesHi, _mm_cmpgt_epi8(bytesHi, fifteen))),
+        _mm_shuffle_epi8(hi, _mm_or_si128(bytesHi, _mm_cmplt_epi8(bytesHi, sixteen)))
+      );
+
+      _mm_storeu_si128((__m128i*)(out + 0), outLo);
+      _mm_storeu_si128((__m128i*)(out + 8), outHi);
+#endif
+      return;
+    }
+#endif
+
+    // Branchless scalar version of RotateBitsLeftKernel(). out may alias in.
+    template <typename T>
+    inline void RotateBitsLeftScalar(T* out, const T* in) {
+      constexpr std::size_t bits = sizeof(T) * 8;
+      const T first = in[0];
+
+      for (std::size_t i = 0; i < 15; i++) {
+        out[i] = (T)((in[i] << 1) | (in[i + 1] >> (bits - 1)));
+      }
+      out[15] = (T)((in[15] << 1) | (first >> (bits - 1)));
+
+      return;
+    }
+
+    // Branchless scalar version of RotateBitsRightKernel(). out may alias in.
+    template <typename T>
+    inline void RotateBitsRightScalar(T* out, const T* in) {
+      constexpr std::size_t bits = sizeof(T) * 8;
+      const T last = in[15];
+
+      for (std::size_t i = 15; i > 0; i--) {
+        out[i] = (T)((in[i] >> 1) | (in[i - 1] << (bits - 1)));
+      }
+      out[0] = (T)((in[0] >> 1) | (last << (bits - 1)));
+
+      return;
+    }
+
+    // Matrix-multiplies two column-major 4x4 matrices: out = a * b.
+    // This is the portable version. out may alias a or b.
+    template <typename T>
+    inline void MMulScalar(T* out, const T* a, const T* b) {
+      T m[16];
+      for (std::size_t column = 0; column < 4; column++) {
+        for (std::size_t row = 0; row < 4; row++) {
+          // Accumulate in 32 bits, so that 16-bit products do not get promoted to (overflowing) signed ints
+          std::uint32_t sum = 0;
+          for (std::size_t k = 0; k < 4; k++) {
+            sum += (std::uint32_t)a[k*4 + row] * (std::uint32_t)b[column*4 + k];
+          }
+          m[column*4 + row] = (T)sum;
+        }
+      }
+
+      memcpy(out, m, sizeof(m));
+      return;
+    }
+
+    // Matrix-multiplies two blocks: out = a * b. out may alias a or b.
+    template <typename T>
+    inline void MMul(T* out, const T* a, const T* b) {
+#ifdef GCRYPT_INTRINSICS_SSE41
+      MMulKernel(out, a, b);
+#else
+      MMulScalar(out, a, b);
+#endif
+      return;
+    }
+
+    // out = a ^ b. out may alias a or b.
+    template <typename T>
+    inline void Xor(T* out, const T* a, const T* b) {
+#ifdef GCRYPT_INTRINSICS_SSE41
+      ElementwiseKernel(out, a, b, [](const Vec x, const Vec y) { return VecXor(x, y); });
+#else
+      for (std::size_t i = 0; i < 16; i++) {
+        out[i] = a[i] ^ b[i];
+      }
+#endif
+      return;
+    }
+
+    // out = a + b, cell by cell. out may alias a or b.
+    template <typename T>
+    inline void Add(T* out, const T* a, const T* b) {
+#ifdef GCRYPT_INTRINSICS_SSE41
+      ElementwiseKernel(out, a, b, [](const Vec x, const Vec y) { return VecAdd(x, y, T()); });
+#else
+      for (std::size_t i = 0; i < 16; i++) {
+        out[i] = a[i] + b[i];
+      }
+#endif
+      return;
+    }
+
+    // out = a - b, cell by cell. out may alias a or b.
+    template <typename T>
+    inline void Sub(T* out, const T* a, const T* b) {
+#ifdef GCRYPT_INTRINSICS_SSE41
+      ElementwiseKernel(out, a, b, [](const Vec x, const Vec y) { return VecSub(x, y, T()); });
+#else
+      for (std::size_t i = 0; i < 16; i++) {
+        out[i] = a[i] - b[i];
+      }
+#endif
+      return;
+    }
+
+    // Rotates all bits of a block to the left by one. out may alias in.
+    template <typename T>
+    inline void RotateBitsLeft(T* out, const T* in) {
+#ifdef GCRYPT_INTRINSICS_SSE41
+      RotateBitsLeftKernel(out, in);
+#else
+      RotateBitsLeftScalar(out, in);
+#endif
+      return;
+    }
+
+    // Rotates all bits of a block to the right by one. out may alias in.
+    template <typename T>
+    inline void RotateBitsRight(T* out, const T* in) {
+#ifdef GCRYPT_INTRINSICS_SSE41
+      RotateBitsRightKernel(out, in);
+#else
+      RotateBitsRightScalar(out, in);
+#endif
+      return;
+    }
+  }
+}
+
+#endif
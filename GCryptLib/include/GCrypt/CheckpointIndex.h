@@ -0,0 +1,64 @@
+#ifndef GCRYPT_CHECKPOINTINDEX_H
+#define GCRYPT_CHECKPOINTINDEX_H
+
+#include "GCrypt/Block.h"
+#include "GCrypt/Key.h"
+#include "GCrypt/Keyset.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace Leonetienne::GCrypt {
+  /** An index of key schedule checkpoints, to decipher a stream from the middle.
+  * Without it, getting to the keyset of block n means rolling the keyset n times from the key.
+  * This saves the key schedule state every `interval` blocks, so it takes at most interval-1 rolls.
+  * Keysets only depend on the key and the block index, so an index only depends on the key and the stream length.
+  *
+  * The saved states are key material. They get stored enciphered with the key,
+  * so an index is as useless without the key as the ciphertext is.
+  */
+  class CheckpointIndex {
+  public:
+    //! The default distance between two checkpoints, in blocks (64 KiB)
+    static constexpr std::size_t DEFAULT_INTERVAL = 1024;
+
+    //! Empty index. It has no checkpoints, so every keyset gets rolled from the key.
+    CheckpointIndex();
+
+    //! Will build the index for a stream of nBlocks blocks, enciphered with key
+    static CheckpointIndex Build(const Key& key, const std::size_t nBlocks, const std::size_t interval = DEFAULT_INTERVAL);
+
+    //! Will return the keyset of a block, rolled from the nearest checkpoint at or before it
+    Keyset KeysetAt(const std::size_t blockIndex, const Key& key) const;
+
+    //! Will return the distance between two checkpoints, in blocks
+    std::size_t GetInterval() const;
+
+    //! Will return the number of blocks of the indexed stream
+    std::size_t GetBlockCount() const;
+
+    //! Will save the index to a file
+    void WriteToFile(const std::string& path) const;
+
+    //! Will load an index from a file
+    static CheckpointIndex LoadFromFile(const std::string& path);
+
+    //! Will save the key schedule state that rolls into the keyset after `previous`, enciphered with key
+    static Block SaveCheckpoint(const Keyset& previous, const Key& key);
+
+    //! Will restore the keyset a checkpoint rolls into
+    static Keyset RestoreCheckpoint(const Block& checkpoint, const Key& key);
+
+    //! Will return where the index of a ciphertext file lives, by convention
+    static std::string SidecarPath(const std::string& ciphertextPath);
+
+  private:
+    std::size_t interval = DEFAULT_INTERVAL;
+    std::size_t nBlocks = 0;
+
+    //! Checkpoint i holds the state to roll into the keyset of block (i+1)*interval, enciphered
+    std::vector<Block> checkpoints;
+  };
+}
+
+#endif
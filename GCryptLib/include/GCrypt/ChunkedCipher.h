@@ -0,0 +1,69 @@
+#ifndef GCRYPT_CHUNKEDCIPHER_H
+#define GCRYPT_CHUNKEDCIPHER_H
+
+#include "GCrypt/Block.h"
+#include "GCrypt/Key.h"
+#include <cstddef>
+#include <string>
+
+namespace Leonetienne::GCrypt {
+  /** Encrypts data as independent chunks, on multiple threads.
+  * A single GCipher stream is one CBC chain, which can only ever be enciphered on one core.
+  * This splits the cleartext into fixed-size chunks instead. Each chunk gets its own CBC chain,
+  * with a key (and thus initialization vector) derived from the master key and the chunk index.
+  *
+  * This is a different format than a plain GCipher stream. The output is a container:
+  * a header block (magic, version, chunk size, original length, number of chunks),
+  * followed by a chunk table (one block per chunk: its offset and length, in blocks),
+  * followed by the enciphered chunks.
+  *
+  * Since chunks are independent, a container can be updated in place (see UpdateFile()).
+  * Only the chunks whose cleartext changed get enciphered and written again.
+  */
+  class ChunkedCipher {
+  public:
+    //! The default chunk size, in bytes (1 MiB)
+    static constexpr std::size_t DEFAULT_CHUNK_SIZE = 1024 * 1024;
+
+    //! Will encrypt bytes into a container, on up to nThreads threads.
+    //! chunkSize has to be a multiple of Block::BLOCK_SIZE.
+    //! nThreads = 0 uses as many threads as the hardware supports.
+    static std::string Encrypt(const std::string& cleartext, const Key& key, const std::size_t chunkSize = DEFAULT_CHUNK_SIZE, const std::size_t nThreads = 0);
+
+    //! Will decrypt a container, on up to nThreads threads.
+    //! nThreads = 0 uses as many threads as the hardware supports.
+    static std::string Decrypt(const std::string& container, const Key& key, const std::size_t nThreads = 0);
+
+    //! Will encrypt a file into a container file.
+    //! Returns false if anything goes wrong (like, file-access).
+    static bool EncryptFile(const std::string& filename_in, const std::string& filename_out, const Key& key, const std::size_t chunkSize = DEFAULT_CHUNK_SIZE, const std::size_t nThreads = 0);
+
+    //! Will decrypt a container file.
+    //! Returns false if anything goes wrong (like, file-access, or a malformed container).
+    static bool DecryptFile(const std::string& filename_in, const std::string& filename_out, const Key& key, const std::size_t nThreads = 0);
+
+    //! Will encrypt a file into a container file, reusing what is already there.
+    //! Keeps a fingerprint of each chunk's cleartext next to the container (see FingerprintPath()).
+    //! If the container and its fingerprints exist, only chunks whose fingerprint changed get rewritten, in place.
+    //! Otherwise, or if the number of chunks changes, the whole container gets written.
+    //! An existing container keeps its chunk size.
+    //! Mind that a rewritten chunk keeps its key and initialization vector,
+    //! so its old and new ciphertext reveal how long a prefix the two versions share, in blocks.
+    //! If nChunksRewritten is given, it receives the number of chunks that got rewritten.
+    //! Returns false if anything goes wrong (like, file-access).
+    static bool UpdateFile(const std::string& filename_in, const std::string& filename_container, const Key& key, const std::size_t chunkSize = DEFAULT_CHUNK_SIZE, const std::size_t nThreads = 0, std::size_t* nChunksRewritten = nullptr);
+
+    //! Will return where the chunk fingerprints of a container live, by convention.
+    //! Fingerprints are keyed, so they tell nothing about the cleartext without the key.
+    static std::string FingerprintPath(const std::string& containerPath);
+
+    //! Will derive the key of a chunk from the master key
+    static Key DeriveChunkKey(const Key& key, const std::size_t chunkIndex);
+
+  private:
+    // No instanciation! >:(
+    ChunkedCipher();
+  };
+}
+
+#endif
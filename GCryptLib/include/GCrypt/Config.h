@@ -8,5 +8,27 @@ namespace Leonetienne::GCrypt {
   constexpr std::size_t N_ROUNDS = 6;
 }
 
+// Vectorized kernels get compiled in, whenever the target instruction set supports them.
+// Define _GCRYPT_NO_INTRINSICS_ to force the portable scalar implementations everywhere.
+#if !defined(_GCRYPT_NO_INTRINSICS_) && defined(__SSE4_1__)
+#define GCRYPT_INTRINSICS_SSE41
+#endif
+
+#if !defined(_GCRYPT_NO_INTRINSICS_) && defined(__AVX2__)
+#define GCRYPT_INTRINSICS_AVX2
+#endif
+
+#if !defined(_GCRYPT_NO_INTRINSICS_) && defined(__AVX512F__) && defined(__AVX512BW__) && defined(__AVX512VL__)
+#define GCRYPT_INTRINSICS_AVX512
+#endif
+
+#if defined(GCRYPT_INTRINSICS_AVX512) && defined(__AVX512VBMI__)
+#define GCRYPT_INTRINSICS_AVX512VBMI
+#endif
+
+#if defined(GCRYPT_INTRINSICS_AVX512) && defined(__AVX512VBMI2__)
+#define GCRYPT_INTRINSICS_AVX512VBMI2
+#endif
+
 #endif
 
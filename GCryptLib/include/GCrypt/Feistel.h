@@ -4,22 +4,30 @@
 #include "GCrypt/Keyset.h"
 #include "GCrypt/Block.h"
 #include "GCrypt/Key.h"
+#include "GCrypt/Config.h"
+#include <utility>
 
 namespace Leonetienne::GCrypt {
-  /** Class to perform a feistel block chipher
+  /** Class to perform a feistel block chipher.
+  * The number of rounds is a template parameter, so that all rounds
+  * can be unrolled at compile time. Use the Feistel typedef for the default configuration.
+  * Explicitly instantiated for N_ROUNDS.
   */
-  class Feistel {
+  template <std::size_t Rounds>
+  class BasicFeistel {
   public:
+    static_assert(Rounds > 0, "A feistel network needs at least one round");
+
     //! Empty initializer. If you use this, you must call SetKey()!
-    Feistel();
+    BasicFeistel();
 
     //! Will initialize the feistel cipher with a key
-    explicit Feistel(const Key& key);
+    explicit BasicFeistel(const Key& key);
 
-    Feistel(const Feistel& other) = delete;
-    Feistel(Feistel&& other) noexcept = delete;
+    BasicFeistel(const BasicFeistel& other) = delete;
+    BasicFeistel(BasicFeistel&& other) noexcept = delete;
 
-    ~Feistel();
+    ~BasicFeistel();
 
     //! Will set the seed-key for this feistel network.
     //! Roundkeys will be derived from this.
@@ -31,12 +39,110 @@ namespace Leonetienne::GCrypt {
     //! Will decipher a data block via the set seed-key
     Block Decipher(const Block& data);
 
-    void operator=(const Feistel& other);
+    //! Will encipher a data block with a given keyset.
+    //! This does not roll any keys. Use RollKeyset() for the next block.
+    static Block Encipher(const Block& data, const BasicKeyset<Rounds>& keyset);
+
+    //! Will encipher a data block with a given keyset, as Encipher() does,
+    //! and generate nextKeyset from nextSeedKey on the side, as GenerateKeyset() does.
+    //! Both are long chains of dependent steps. Woven into each other, the cpu can overlap them.
+    //! nextKeyset must not alias keyset.
+    static Block EncipherAndGenerateKeyset(const Block& data, const BasicKeyset<Rounds>& keyset, BasicKeyset<Rounds>& nextKeyset, const Key& nextSeedKey);
+
+    //! Will decipher a data block with a given keyset.
+    //! This does not roll any keys. Use RollKeyset() for the next block.
+    static Block Decipher(const Block& data, const BasicKeyset<Rounds>& keyset);
+
+    //! Will encipher Lanes independent blocks in place, block i with keysets[i].
+    //! All lanes run through each step of the rounds together, so that their latencies overlap.
+    //! This does not roll any keys. Explicitly instantiated for 4, 8 and 16 lanes.
+    template <std::size_t Lanes>
+    static void EncipherLanes(Block* blocks, const BasicKeyset<Rounds>* const* keysets);
+
+    //! Will decipher Lanes independent blocks in place, block i with keysets[i].
+    //! This does not roll any keys. Explicitly instantiated for 4, 8 and 16 lanes.
+    template <std::size_t Lanes>
+    static void DecipherLanes(Block* blocks, const BasicKeyset<Rounds>* const* keysets);
+
+    //! Will decipher Lanes independent blocks in place, as DecipherLanes() does,
+    //! and roll the keysets that come after them on the side: keysets[Lanes-1] into nextKeysets[0],
+    //! nextKeysets[0] into nextKeysets[1], and so on. nextKeysets must not alias keysets.
+    //! The rolls are one long chain of dependent steps. Woven into the rounds, the cpu can overlap both.
+    //! Explicitly instantiated for 4, 8 and 16 lanes.
+    template <std::size_t Lanes>
+    static void DecipherLanesAndRoll(Block* blocks, const BasicKeyset<Rounds>* const* keysets, BasicKeyset<Rounds>* const* nextKeysets);
+
+    //! Will derive a keyset from a seed-key, as SetKey() does
+    static void GenerateKeyset(BasicKeyset<Rounds>& keyset, const Key& seedKey);
+
+    //! Will advance a keyset to the one of the next block, as each block does after de*ciphering.
+    //! The keyset of a block depends only on the seed-key and the block index, never on the data.
+    static void RollKeyset(BasicKeyset<Rounds>& keyset);
+
+    //! Will advance Lanes independent keysets, as RollKeyset() does, side by side.
+    //! Explicitly instantiated for 4, 8 and 16 lanes.
+    template <std::size_t Lanes>
+    static void RollKeysetLanes(BasicKeyset<Rounds>* const* keysets);
+
+    //! Will return the keyset the next block will get de*ciphered with
+    BasicKeyset<Rounds> GetNextKeyset() const;
+
+    //! Will continue with the given keyset for the next block, as if it had been rolled into
+    void SetNextKeyset(const BasicKeyset<Rounds>& keyset);
+
+    //! Will derive the reduced round keys of a keyset from its round keys
+    static void DeriveReducedRoundKeys(BasicKeyset<Rounds>& keyset);
+
+    void operator=(const BasicFeistel& other);
 
   private:
+    //! Will run the feistel rounds on the own keyset, and roll it
+    template <bool modeEncrypt>
+    Block Run(const Block& data);
+
     //! Will run the feistel rounds, with either regular key
     //! order or reversed key order
-    Block Run(const Block& data, bool modeEncrypt);
+    template <bool modeEncrypt>
+    static Block Run(const Block& data, const BasicKeyset<Rounds>& keyset);
+
+    //! Will run the feistel rounds, and roll keyset into nextKeyset on the side
+    template <bool modeEncrypt>
+    static Block RunAndRoll(const Block& data, const BasicKeyset<Rounds>& keyset, BasicKeyset<Rounds>& nextKeyset);
+
+    //! Will run all rounds, unrolled.
+    //! If rollKeys, the rounds derive the round keys of nextKeyset on the side (see RoundFunction()).
+    template <bool modeEncrypt, bool rollKeys, std::size_t... roundIndices>
+    static void RunRounds(Halfblock& l, Halfblock& r, const BasicKeyset<Rounds>& keyset, BasicKeyset<Rounds>* nextKeyset, std::index_sequence<roundIndices...>);
+
+    //! Will run a single round
+    template <bool modeEncrypt, bool rollKeys, std::size_t roundIndex>
+    static void Round(Halfblock& l, Halfblock& r, const BasicKeyset<Rounds>& keyset, BasicKeyset<Rounds>* nextKeyset);
+
+    //! Will apply F to a round.
+    //! If rollKeys, round key roundIndex+1 of nextKeyset gets derived in between the steps of F.
+    //! Neither depends on the other, so the cpu can overlap both chains of matrix multiplications.
+    template <bool rollKeys, std::size_t roundIndex>
+    static Halfblock RoundFunction(const Halfblock& m, const Key& key, BasicKeyset<Rounds>* nextKeyset);
+
+    //! Will run the feistel rounds on Lanes blocks, side by side.
+    //! sideWork() gets called in between the steps of each round, to weave in independent work.
+    template <bool modeEncrypt, std::size_t Lanes, typename SideWork>
+    static void RunLanes(Block* blocks, const BasicKeyset<Rounds>* const* keysets, const SideWork& sideWork);
+
+    //! Will run all rounds on Lanes blocks, unrolled
+    template <bool modeEncrypt, std::size_t Lanes, typename SideWork, std::size_t... roundIndices>
+    static void RunRoundsLanes(Halfblock* l, Halfblock* r, const BasicKeyset<Rounds>* const* keysets, const SideWork& sideWork, std::index_sequence<roundIndices...>);
+
+    //! Will run a single round on Lanes blocks
+    template <bool modeEncrypt, std::size_t roundIndex, std::size_t Lanes, typename SideWork>
+    static void RoundLanes(Halfblock* l, Halfblock* r, const BasicKeyset<Rounds>* const* keysets, const SideWork& sideWork);
+
+    //! Will clear a keyset and seed its first round key, as RollKeyset() does before deriving the others
+    static void SeedRoll(BasicKeyset<Rounds>& keyset);
+
+    //! Will derive the round key after lastKeys[i] into roundKeys[i], for Lanes independent keys side by side
+    template <std::size_t Lanes>
+    static void DeriveNextRoundKeys(Key* const* roundKeys, const Key* const* lastKeys);
 
     //! Arbitrary cipher function
     static Halfblock F(Halfblock m, const Key& key);
@@ -56,16 +162,23 @@ namespace Leonetienne::GCrypt {
     //! Substitutes eight bits by static random others, inplace
     static void SBox(Block& block);
 
-    //! Will generate a the round keys
+    //! Will generate a the round keys, and everything derived from them
     void GenerateRoundKeys(const Key& seedKey);
 
     //! Will zero the memory used by the keyset
     void ZeroKeyMemory();
 
-    Keyset roundKeys;
+    //! The keyset of the next block
+    BasicKeyset<Rounds> keyset;
+
+    //! Where the keyset after it gets rolled into, while a block runs through its rounds
+    BasicKeyset<Rounds> nextKeyset;
 
     bool isInitialized = false;
   };
+
+  //! The feistel network, as configured in Config.h
+  typedef BasicFeistel<N_ROUNDS> Feistel;
 }
 
 #endif
@@ -0,0 +1,307 @@
+#ifndef GCRYPT_FEISTELKERNELS_H
+#define GCRYPT_FEISTELKERNELS_H
+
+#include <cstdint>
+#include <cstring>
+#include "GCrypt/Config.h"
+#include "GCrypt/Block.h"
+#include "GCrypt/BlockKernels.h"
+#include "GCrypt/SBoxLookup.h"
+
+// The compute kernels behind the feistel function, working on plain arrays of 16 cells.
+// This header is internal to GCrypt. Like the block kernels, these have internal linkage.
+namespace Leonetienne::GCrypt::Kernels {
+  namespace {
+    // Mixes up the expanded block inside F
+    // (shift cells right, then shift rows up)
+    constexpr BlockPermutation F_MIXING_PERMUTATION =
+      BlockPermutation::ShiftCellsRight().Then(BlockPermutation::ShiftRowsUp());
+
+    // The cell permutations of the key schedule
+    constexpr BlockPermutation KEY_STIR_PERMUTATION = BlockPermutation::ShiftRowsUp();
+    constexpr BlockPermutation KEY_MUTATION_PERMUTATION = BlockPermutation::ShiftCellsRight();
+    constexpr BlockPermutation KEY_SEAL_PERMUTATION = BlockPermutation::ShiftColumnsRight();
+
+#if defined(GCRYPT_INTRINSICS_AVX512VBMI)
+    // Substitutes all 64 bytes in one zmm register.
+    // vpermi2b looks up 128 table entries at once (by the lower 7 bits of each byte),
+    // so do one lookup per table half, and pick by the msb of each byte.
+    // Byte 0 gets left unchanged.
+    inline void SBoxKernel(std::uint8_t* bytes) {
+      const __m512i table0 = _mm512_loadu_si512(sboxLookup.data() + 0);
+      const __m512i table1 = _mm512_loadu_si512(sboxLookup.data() + 64);
+      const __m512i table2 = _mm512_loadu_si512(sboxLookup.data() + 128);
+      const __m512i table3 = _mm512_loadu_si512(sboxLookup.data() + 192);
+
+      const __m512i x = _mm512_loadu_si512(bytes);
+      const __m512i lowerHalf = _mm512_permutex2var_epi8(table0, x, table1);
+      const __m512i upperHalf = _mm512_permutex2var_epi8(table2, x, table3);
+      const __m512i substituted = _mm512_mask_blend_epi8(_mm512_movepi8_mask(x), lowerHalf, upperHalf);
+
+      _mm512_storeu_si512(bytes, _mm512_mask_blend_epi8(~1ull, x, substituted));
+      return;
+    }
+#elif defined(GCRYPT_INTRINSICS_SSE41)
+#ifdef GCRYPT_INTRINSICS_AVX2
+    inline Vec VecBroadcast(const void* p) { return _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)p)); }
+    inline Vec VecSet1(const char c) { return _mm256_set1_epi8(c); }
+    inline Vec VecZero() { return _mm256_setzero_si256(); }
+    inline Vec VecAddsU8(const Vec a, const Vec b) { return _mm256_adds_epu8(a, b); }
+    inline Vec VecShuffleU8(const Vec a, const Vec b) { return _mm256_shuffle_epi8(a, b); }
+    inline Vec VecBlendU8(const Vec a, const Vec b, const Vec mask) { return _mm256_blendv_epi8(a, b, mask); }
+    inline Vec VecFirstByteMask() { return _mm256_setr_epi64x(0xFF, 0, 0, 0); }
+#else
+    inline Vec VecBroadcast(const void* p) { return _mm_loadu_si128((const __m128i*)p); }
+    inline Vec VecSet1(const char c) { return _mm_set1_epi8(c); }
+    inline Vec VecZero() { return _mm_setzero_si128(); }
+    inline Vec VecAddsU8(const Vec a, const Vec b) { return _mm_adds_epu8(a, b); }
+    inline Vec VecShuffleU8(const Vec a, const Vec b) { return _mm_shuffle_epi8(a, b); }
+    inline Vec VecBlendU8(const Vec a, const Vec b, const Vec mask) { return _mm_blendv_epi8(a, b, mask); }
+    inline Vec VecFirstByteMask() { return _mm_setr_epi32(0xFF, 0, 0, 0); }
+#endif
+
+    // Substitutes all 64 bytes with pshufb lookups, split by nibbles.
+    // Row h of the table (the 16 entries with high nibble h) gets looked up by the low nibble of every byte.
+    // Xoring with h<<4, and saturated-adding 0x70, leaves bytes of that row in 0x70..0x7f, and pushes
+    // all other bytes to >= 0x80, which pshufb zeroes. Or-ing all 16 rows together yields the substitution.
+    // Byte 0 gets left unchanged.
+    inline void SBoxKernel(std::uint8_t* bytes) {
+      constexpr std::size_t nVecs = 64 / sizeof(Vec);
+      const Vec rowOffset = VecSet1(0x70);
+
+      Vec x[nVecs];
+      Vec substituted[nVecs];
+      for (std::size_t i = 0; i < nVecs; i++) {
+        x[i] = VecLoad(bytes + i*sizeof(Vec));
+        substituted[i] = VecZero();
+      }
+
+      for (int h = 0; h < 16; h++) {
+        const Vec row = VecBroadcast(sboxLookup.data() + h*16);
+        const Vec rowSelector = VecSet1((char)(h << 4));
+
+        for (std::size_t i = 0; i < nVecs; i++) {
+          const Vec indices = VecAddsU8(VecXor(x[i], rowSelector), rowOffset);
+          substituted[i] = VecOr(substituted[i], VecShuffleU8(row, indices));
+        }
+      }
+
+      substituted[0] = VecBlendU8(substituted[0], x[0], VecFirstByteMask());
+
+      for (std::size_t i = 0; i < nVecs; i++) {
+        VecStore(bytes + i*sizeof(Vec), substituted[i]);
+      }
+
+      return;
+    }
+#endif
+
+    // Substitutes the bytes of a block (64 bytes) through the sbox.
+    // Historically, this substitutes all bytes but the first one.
+    // The ciphertexts depend on it, so it stays this way.
+    inline void SBox(std::uint8_t* bytes) {
+#if defined(GCRYPT_INTRINSICS_AVX512VBMI) || defined(GCRYPT_INTRINSICS_SSE41)
+      SBoxKernel(bytes);
+#else
+      for (std::size_t i = 1; i < 64; i++) {
+        bytes[i] = sboxLookup[bytes[i]];
+      }
+#endif
+      return;
+    }
+
+    // Widens the 16 cells of a halfblock to 32 bits
+    inline void Widen(std::uint32_t* out, const std::uint16_t* in) {
+#if defined(GCRYPT_INTRINSICS_AVX512)
+      _mm512_storeu_si512(out, _mm512_cvtepu16_epi32(_mm256_loadu_si256((const __m256i*)in)));
+#elif defined(GCRYPT_INTRINSICS_SSE41)
+      for (std::size_t i = 0; i < 16; i += 4) {
+        _mm_storeu_si128((__m128i*)(out + i), _mm_cvtepu16_epi32(_mm_loadl_epi64((const __m128i*)(in + i))));
+      }
+#else
+      for (std::size_t i = 0; i < 16; i++) {
+        out[i] = in[i];
+      }
+#endif
+      return;
+    }
+
+    // Widens the 16 cells of a halfblock to 32 bits, and multiplies the result
+    // three times with a bit-rotated version of itself.
+    inline void Expand(std::uint32_t* out, const std::uint16_t* in) {
+      Widen(out, in);
+
+      std::uint32_t rotated[16];
+      for (std::size_t i = 0; i < 3; i++) {
+        RotateBitsRight(rotated, out);
+        MMul(out, out, rotated);
+      }
+
+      return;
+    }
+
+    // Maps the 16 cells of a block onto 15 bits each, and narrows them to a halfblock.
+    inline void Reduce(std::uint16_t* out, const std::uint32_t* in) {
+#if defined(GCRYPT_INTRINSICS_AVX512)
+      const __m512i x = _mm512_and_si512(_mm512_loadu_si512(in), _mm512_set1_epi32(0x7FFF));
+      _mm256_storeu_si256((__m256i*)out, _mm512_cvtepi32_epi16(x));
+#elif defined(GCRYPT_INTRINSICS_AVX2)
+      // All cells fit into 15 bits, so the saturating pack does not saturate.
+      // packus works per lane, which interleaves the quarters. permute4x64 sorts them back.
+      const __m256i mask = _mm256_set1_epi32(0x7FFF);
+      const __m256i lo = _mm256_and_si256(_mm256_loadu_si256((const __m256i*)(in + 0)), mask);
+      const __m256i hi = _mm256_and_si256(_mm256_loadu_si256((const __m256i*)(in + 8)), mask);
+      _mm256_storeu_si256((__m256i*)out, _mm256_permute4x64_epi64(_mm256_packus_epi32(lo, hi), 0xD8));
+#elif defined(GCRYPT_INTRINSICS_SSE41)
+      const __m128i mask = _mm_set1_epi32(0x7FFF);
+      for (std::size_t i = 0; i < 16; i += 8) {
+        const __m128i lo = _mm_and_si128(_mm_loadu_si128((const __m128i*)(in + i + 0)), mask);
+        const __m128i hi = _mm_and_si128(_mm_loadu_si128((const __m128i*)(in + i + 4)), mask);
+        _mm_storeu_si128((__m128i*)(out + i), _mm_packus_epi32(lo, hi));
+      }
+#else
+      for (std::size_t i = 0; i < 16; i++) {
+        out[i] = (std::uint16_t)(in[i] % (1 << 15));
+      }
+#endif
+      return;
+    }
+
+    // The key schedule derives each round key from the one before, in this many steps
+    constexpr std::size_t KEY_DERIVATION_STEPS = 5;
+
+    // Does one step of deriving a round key from the one before.
+    // Split into steps, so that the derivation can be woven into other work.
+    // key must not alias lastKey.
+    inline void DeriveRoundKeyStep(const std::size_t step, std::uint32_t* key, const std::uint32_t* lastKey) {
+      switch (step) {
+        // Initialize new round key with last round key, and stir it good
+        case 0:
+          PermuteCells(key, lastKey, KEY_STIR_PERMUTATION.Data());
+          break;
+
+        // Bitshift and matrix-mult 3 times
+        // (each time jumbles it up pretty good)
+        // This is irreversible
+        case 1:
+        case 2:
+        case 3:
+          RotateBitsRight(key, key);
+          MMul(key, key, lastKey);
+          break;
+
+        // Lastly, do apply some cell shifting, and other mutations
+        default:
+          PermuteCells(key, key, KEY_MUTATION_PERMUTATION.Data());
+          Add(key, key, lastKey);
+          PermuteCells(key, key, KEY_SEAL_PERMUTATION.Data());
+          Xor(key, key, lastKey);
+          break;
+      }
+
+      return;
+    }
+
+    // The feistel function, fused into one pass over a single stack buffer:
+    // expand m, mix it up, matrix-multiply with the key, rotate its bits, substitute its bytes,
+    // reduce it back to a halfblock, and matrix-multiply that with m.
+    // out may alias m.
+    inline void F(std::uint16_t* out, const std::uint16_t* m, const std::uint32_t* key) {
+      alignas(64) std::uint32_t expanded[16];
+
+      Expand(expanded, m);
+      PermuteCells(expanded, expanded, F_MIXING_PERMUTATION.Data());
+      MMul(expanded, expanded, key);
+      RotateBitsLeft(expanded, expanded);
+      SBox((std::uint8_t*)(void*)expanded);
+
+      alignas(32) std::uint16_t reduced[16];
+      Reduce(reduced, expanded);
+      MMul(out, reduced, m);
+
+      return;
+    }
+
+    // The feistel function, with the derivation of a round key woven in between its steps.
+    // Both are long chains of dependent matrix multiplications, but neither depends on the other.
+    // Interleaving them lets the cpu overlap the two.
+    // out may alias m. nextKey must not alias lastKey.
+    inline void FAndDeriveRoundKey(std::uint16_t* out, const std::uint16_t* m, const std::uint32_t* key, std::uint32_t* nextKey, const std::uint32_t* lastKey) {
+      alignas(64) std::uint32_t expanded[16];
+      std::uint32_t rotated[16];
+
+      Widen(expanded, m);
+      DeriveRoundKeyStep(0, nextKey, lastKey);
+
+      for (std::size_t i = 0; i < 3; i++) {
+        RotateBitsRight(rotated, expanded);
+        MMul(expanded, expanded, rotated);
+        DeriveRoundKeyStep(1 + i, nextKey, lastKey);
+      }
+
+      PermuteCells(expanded, expanded, F_MIXING_PERMUTATION.Data());
+      MMul(expanded, expanded, key);
+      DeriveRoundKeyStep(4, nextKey, lastKey);
+      RotateBitsLeft(expanded, expanded);
+      SBox((std::uint8_t*)(void*)expanded);
+
+      alignas(32) std::uint16_t reduced[16];
+      Reduce(reduced, expanded);
+      MMul(out, reduced, m);
+
+      return;
+    }
+
+    // The feistel function on Lanes independent halfblocks, each with its own key.
+    // Every step runs on all lanes before the next one starts. A single F is one long chain of
+    // dependent matrix multiplications, so this gives the cpu independent work to overlap them with.
+    // between() gets called after each step, to weave in even more independent work.
+    // out[i] may alias m[i].
+    template <std::size_t Lanes, typename Between>
+    inline void FLanes(std::uint16_t* const* out, const std::uint16_t* const* m, const std::uint32_t* const* keys, Between&& between) {
+      alignas(64) std::uint32_t expanded[Lanes][16];
+
+      for (std::size_t i = 0; i < Lanes; i++) {
+        Expand(expanded[i], m[i]);
+      }
+      between();
+      for (std::size_t i = 0; i < Lanes; i++) {
+        PermuteCells(expanded[i], expanded[i], F_MIXING_PERMUTATION.Data());
+      }
+      between();
+      for (std::size_t i = 0; i < Lanes; i++) {
+        MMul(expanded[i], expanded[i], keys[i]);
+      }
+      between();
+      for (std::size_t i = 0; i < Lanes; i++) {
+        RotateBitsLeft(expanded[i], expanded[i]);
+      }
+      between();
+      for (std::size_t i = 0; i < Lanes; i++) {
+        SBox((std::uint8_t*)(void*)expanded[i]);
+      }
+      between();
+
+      alignas(32) std::uint16_t reduced[Lanes][16];
+      for (std::size_t i = 0; i < Lanes; i++) {
+        Reduce(reduced[i], expanded[i]);
+      }
+      between();
+      for (std::size_t i = 0; i < Lanes; i++) {
+        MMul(out[i], reduced[i], m[i]);
+      }
+      between();
+
+      return;
+    }
+
+    // The feistel function on Lanes independent halfblocks, each with its own key
+    template <std::size_t Lanes>
+    inline void FLanes(std::uint16_t* const* out, const std::uint16_t* const* m, const std::uint32_t* const* keys) {
+      FLanes<Lanes>(out, m, keys, []() {});
+      return;
+    }
+  }
+}
+
+#endif
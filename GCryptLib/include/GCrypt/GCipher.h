@@ -1,24 +1,36 @@
 #ifndef GCRYPT_GCIPHER_H
 #define GCRYPT_GCIPHER_H
 
-#include "GCrypt/Feistel.h"
+#include "GCrypt/BasicGCipher.h"
+#include "GCrypt/GCipherState.h"
+#include "GCrypt/KeysetLookahead.h"
+#include <memory>
 
 namespace Leonetienne::GCrypt {
-  /** Class to apply a block/-stream cipher to messages of arbitrary length in a distributed manner
+  /** Class to apply a block/-stream cipher to messages of arbitrary length in a distributed manner.
+  * Runs in CBC mode, with the direction and key schedule picked at runtime.
+  * Where both are known at compile time, BasicGCipher does the same without any per-block dispatch.
   */
   class GCipher {
   public:
     //! Describes the direction the cipher runs in
-    enum class DIRECTION {
-      ENCIPHER,
-      DECIPHER
+    typedef CIPHER_DIRECTION DIRECTION;
+
+    //! Describes where the keysets of upcoming blocks get computed
+    enum class KEY_SCHEDULE {
+      //! In between blocks, on the digesting thread
+      INLINE,
+
+      //! Ahead of time, on a background thread.
+      //! Leaves only the feistel rounds and the chaining to the digesting thread.
+      LOOKAHEAD
     };
 
     //! Empty initializer. If you use this, you must call Initialize()!
     GCipher();
 
     //! Will initialize this cipher with a key
-    explicit GCipher(const Key& key, const DIRECTION direction);
+    explicit GCipher(const Key& key, const DIRECTION direction, const KEY_SCHEDULE keySchedule = KEY_SCHEDULE::INLINE);
 
     // Disable copying
     GCipher(const GCipher& other) = delete;
@@ -27,24 +39,55 @@ namespace Leonetienne::GCrypt {
     //! Will digest a data block, and return it
     Block Digest(const Block& input);
 
+    //! Will digest n consecutive data blocks in place.
+    //! Yields exactly what n calls to Digest() yield.
+    //! When deciphering, runs of consecutive blocks go through the feistel rounds side by side,
+    //! on this thread (see CipherModes::CBC::DecipherInplace()).
+    void DigestInplace(Block* blocks, const std::size_t n);
+
+    //! Will digest consecutive data blocks in place
+    void DigestInplace(std::vector<Block>& blocks);
+
     //! Will update the base key used
     void SetKey(const Key& key);
 
     void operator=(const GCipher& other);
 
+    //! Will snapshot where the stream is at, so that it can be continued later (see RestoreState()).
+    //! The snapshot contains key material!
+    GCipherState SaveState() const;
+
+    //! Will continue a stream from a snapshot, as if no block had been digested since it got taken.
+    //! The key schedule is not part of the snapshot.
+    //! If called on an existing object, it will reset its state.
+    void RestoreState(const GCipherState& state, const KEY_SCHEDULE keySchedule = KEY_SCHEDULE::INLINE);
+
 
     //! Will initialize the cipher with a key, and a mode.
     //! If called on an existing object, it will reset its state.
-    void Initialize(const Key& key, const DIRECTION direction);
+    void Initialize(const Key& key, const DIRECTION direction, const KEY_SCHEDULE keySchedule = KEY_SCHEDULE::INLINE);
 
   private:
+    //! Will digest a data block in the given direction, taking its keyset from the given key schedule
+    template <DIRECTION digestDirection, KEY_SCHEDULE digestKeySchedule>
+    Block DigestBlock(const Block& input);
+
+    //! Will return the block digestion routine for a direction and key schedule
+    typedef Block (GCipher::*DigestFunction)(const Block&);
+    static DigestFunction SelectDigestFunction(const DIRECTION direction, const KEY_SCHEDULE keySchedule);
+
     DIRECTION direction;
 
-    //! The feistel instance to be used
-    Feistel feistel;
+    KEY_SCHEDULE keySchedule = KEY_SCHEDULE::INLINE;
+
+    //! The block digestion routine, selected once per stream by direction
+    DigestFunction digestFunction = nullptr;
+
+    //! The chaining, and the keyset, if the key schedule is INLINE
+    CipherModes::CBC<N_ROUNDS> cbc;
 
-    //! The last block, required for CBC.
-    Block lastBlock;
+    //! Computes upcoming keysets, if the key schedule is LOOKAHEAD
+    std::unique_ptr<KeysetLookahead> keysetLookahead;
 
     bool isInitialized = false;
   };
@@ -0,0 +1,73 @@
+#ifndef GCRYPT_GCIPHERSTATE_H
+#define GCRYPT_GCIPHERSTATE_H
+
+#include "GCrypt/BasicGCipher.h"
+#include "GCrypt/Keyset.h"
+#include <string>
+
+namespace Leonetienne::GCrypt {
+  /** A snapshot of where a GCipher stream is at, to continue it later.
+  * Holds the direction, the last ciphertext block, and the keyset of the next block,
+  * packed into a small, versioned byte blob (a header block, the last block, and one block per round key).
+  *
+  * The keyset is key material, so a snapshot is as sensitive as the key itself.
+  * Its memory gets zeroed on destruction.
+  */
+  class GCipherState {
+  public:
+    //! Identifies state blobs: "GCST"
+    static constexpr std::uint32_t MAGIC = 0x54534347;
+    static constexpr std::uint32_t VERSION = 1;
+
+    //! Empty state. Restoring it throws.
+    GCipherState();
+
+    //! Will pack a state
+    GCipherState(const CIPHER_DIRECTION direction, const Keyset& nextKeyset, const Block& lastBlock);
+
+    //! Will take a blob, as returned by GetBytes().
+    //! Throws std::runtime_error, if it is not a (compatible) state.
+    explicit GCipherState(const std::string& bytes);
+
+    GCipherState(const GCipherState& other);
+
+    ~GCipherState();
+
+    void operator=(const GCipherState& other);
+
+    //! Will return the blob
+    const std::string& GetBytes() const;
+
+    //! Will return whether this state is empty
+    bool IsEmpty() const;
+
+    //! Will return the direction the stream runs in
+    CIPHER_DIRECTION GetDirection() const;
+
+    //! Will return the keyset of the next block
+    Keyset GetNextKeyset() const;
+
+    //! Will return the last ciphertext block
+    Block GetLastBlock() const;
+
+    //! Will save the blob to a file
+    void WriteToFile(const std::string& path) const;
+
+    //! Will load a blob from a file
+    static GCipherState LoadFromFile(const std::string& path);
+
+  private:
+    //! Will return block i of the blob
+    Block GetBlock(const std::size_t i) const;
+
+    //! Will make sure the blob is a state this build can continue
+    void Validate() const;
+
+    //! Will zero the memory used by the blob
+    void ZeroStateMemory();
+
+    std::string bytes;
+  };
+}
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef GCRYPT_GCOUNTERCIPHER_H
+#define GCRYPT_GCOUNTERCIPHER_H
+
+#include "GCrypt/BasicGCipher.h"
+#include <cstddef>
+#include <vector>
+
+namespace Leonetienne::GCrypt {
+  /** Class to apply the block cipher to messages of arbitrary length in counter mode (see CipherModes::Counter).
+  * Keystream block i is the encipherment of (nonce || i), under a stream key derived from the key.
+  * It gets xored into data block i. Enciphering and deciphering are the same operation.
+  *
+  * Unlike GCipher (CBC), no block depends on any other block, in either direction.
+  * Blocks can be digested on multiple threads, and any block can be digested right away (see Seek()).
+  *
+  * The keystream only depends on the key and the nonce. Never digest two different messages
+  * with the same key and nonce, or the xor of both ciphertexts is the xor of both cleartexts.
+  * That is why there is no nonce derived from the key. Pick a fresh one per message, like Key::Random(),
+  * and keep it next to the ciphertext (see GWrapper::MODE::COUNTER).
+  */
+  class GCounterCipher {
+  public:
+    //! Empty initializer. If you use this, you must call Initialize()!
+    GCounterCipher();
+
+    //! Will initialize this cipher with a key, and a nonce
+    GCounterCipher(const Key& key, const Block& nonce);
+
+    // Disable copying
+    GCounterCipher(const GCounterCipher& other) = delete;
+    GCounterCipher(GCounterCipher&& other) noexcept = delete;
+
+    //! Will digest a data block, and return it.
+    //! Digests ciphertext to cleartext, and cleartext to ciphertext.
+    Block Digest(const Block& input);
+
+    //! Will digest n data blocks in place, on up to nThreads threads.
+    //! nThreads = 0 uses as many threads as the hardware supports.
+    void DigestInplace(Block* blocks, const std::size_t n, std::size_t nThreads = 0);
+
+    //! Will digest data blocks in place, on up to nThreads threads.
+    //! nThreads = 0 uses as many threads as the hardware supports.
+    void DigestInplace(std::vector<Block>& blocks, const std::size_t nThreads = 0);
+
+    //! Will make the next digested block the one at blockIndex
+    void Seek(const std::size_t blockIndex);
+
+    //! Will return the index of the next block to be digested
+    std::size_t GetPosition() const;
+
+    //! Will initialize the cipher with a key, and a nonce.
+    //! If called on an existing object, it will reset its state.
+    void Initialize(const Key& key, const Block& nonce);
+
+    //! Blocks get split into ranges no shorter than this, so that tiny inputs do not pay for threads they do not need
+    static constexpr std::size_t MIN_BLOCKS_PER_THREAD = 64;
+
+  private:
+    CipherModes::Counter<N_ROUNDS> counter;
+
+    bool isInitialized = false;
+  };
+}
+
+#endif
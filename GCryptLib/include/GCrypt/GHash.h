@@ -2,11 +2,20 @@
 #define GCRYPT_GHASH_H
 
 #include "GCrypt/Block.h"
-#include "GCrypt/GCipher.h"
+#include "GCrypt/Keyset.h"
+#include <array>
+#include <string>
 #include <vector>
 
 namespace Leonetienne::GCrypt {
-  /** This class implements a hash function, based on the GCrypt cipher
+  /** This class implements a hash function, based on the GCrypt cipher.
+  * Inputs can be hashed whole (see CalculateHashsum()), or streamed through Update() and Finalize(),
+  * which never hold more than BUFFER_BLOCKS blocks of the input.
+  *
+  * Each block gets enciphered in CBC mode, with itself as the key. Its keyset only depends on the block,
+  * never on the chain. So the bulk paths generate the keyset of each block while the block before it
+  * goes through the rounds (see BasicFeistel::EncipherAndGenerateKeyset()).
+  * Only the feistel rounds and the xor are on the serial chain.
   */
   class GHash {
   public:
@@ -15,12 +24,40 @@ namespace Leonetienne::GCrypt {
     //! Will add the hash value of the block `data` to the hashsum.
     //! WARNING: If you compute hashes using this digestive method,
     //! you REALLY REALLY should add a trailing block just containing the cleartext size!
-    //! You MOST LIKELY just want to use the wrapper function GHash::CalculateHashsum(Flexblock const&) instead!
+    //! You MOST LIKELY just want to use the wrapper function GHash::CalculateHashsum(), or Update() and Finalize() instead!
     void Digest(const Block& data);
 
+    //! Will add the hash values of n blocks to the hashsum, in order.
+    //! Yields exactly what n calls to Digest() yield, but generates the keyset of each block alongside the block before it.
+    //! The same WARNING as for Digest() applies.
+    void Digest(const Block* blocks, const std::size_t n);
+
     //! Will return the current hashsum
     const Block& GetHashsum() const;
 
+    //! Will feed n bytes of input to the hash.
+    //! Bytes that do not fill a whole block get buffered until the next call, or until Finalize().
+    //! Do not mix this with Digest() on the same hasher.
+    void Update(const char* bytes, const std::size_t n);
+
+    //! Will feed a string of bytes to the hash
+    void Update(const std::string& bytes);
+
+    //! Will digest the buffered bytes, zero-padded, and the length block, just like CalculateHashsum() does.
+    //! Returns the hashsum. No more bytes can be fed afterwards.
+    //! Feeding the bytes of `blocks` yields the same hashsum as CalculateHashsum(blocks, n_bytes).
+    Block Finalize();
+
+    //! Will calculate the hashsum of a file, streaming it in large reads.
+    //! Equals CalculateHashsum(ReadFileToBlocks(filepath, n_bytes), n_bytes).
+    static Block HashFile(const std::string& filepath);
+
+    //! How many bytes HashFile() reads at once
+    static constexpr std::size_t FILE_READ_SIZE = 1024 * 1024;
+
+    //! How many blocks Update() buffers, to digest them in one run (see Digest(const Block*, n))
+    static constexpr std::size_t BUFFER_BLOCKS = 64;
+
     //! Will calculate a hashsum for `blocks`.
     //! Whilst n_bytes is optional, it is HIGHLY recommended to supply.
     //! Without specifying the size of the input (doesn't always have to be 512*n bits)
@@ -30,14 +67,31 @@ namespace Leonetienne::GCrypt {
     //! Will calculate a hashsum for a string
     static Block HashString(const std::string& str);
 
+    //! Will return the trailing block CalculateHashsum() digests, to encode the size of the input
+    static Block LengthBlock(const std::size_t n_bytes);
+
     void operator=(const GHash& other);
 
   private:
-    //! The cipher to use
-    GCipher cipher;
+    //! Will encipher a block with its keyset, and add it to the hashsum
+    void DigestWithKeyset(const Block& data, const Keyset& keyset);
+
+    //! The last ciphertext block, that the next block gets chained to
+    Block lastBlock;
 
     //! The current state of the hashsum
     Block block;
+
+    //! Bytes fed by Update() that do not fill a whole run of BUFFER_BLOCKS blocks yet
+    std::array<Block, BUFFER_BLOCKS> buffer;
+
+    //! How many bytes of buffer are in use
+    std::size_t nBuffered = 0;
+
+    //! How many bytes have been fed by Update() in total
+    std::size_t nBytesFed = 0;
+
+    bool isFinalized = false;
   };
 }
 
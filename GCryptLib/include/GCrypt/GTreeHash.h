@@ -0,0 +1,97 @@
+#ifndef GCRYPT_GTREEHASH_H
+#define GCRYPT_GTREEHASH_H
+
+#include "GCrypt/Block.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Leonetienne::GCrypt {
+  /** A tree hash on top of GHash, for inputs large enough to be worth hashing on multiple threads.
+  * GHash is one serial chain through the whole input, so it only ever uses one core.
+  * This hash splits the input into leaves of LEAF_SIZE bytes, and hashes each leaf with its own GHash.
+  * Leaves do not depend on each other, so batches of them get hashed on multiple threads.
+  * Parent nodes hash the digests of their two children, up to a single root.
+  *
+  * The tree is left-balanced: a left subtree always covers a power of two leaves.
+  * Only the digests of complete subtrees get kept, so memory stays in O(log n) of the input.
+  *
+  * THIS IS NOT GHASH. The same input yields a different hashsum than GHash yields.
+  * Every node digests a header with MAGIC and VERSION, so that hashsums of different
+  * versions of this tree never get mistaken for one another. Compare hashsums only with the same version.
+  */
+  class GTreeHash {
+  public:
+    //! Marks a node of this tree hash
+    static constexpr std::uint32_t MAGIC = 0x48544347;
+
+    //! Bumped whenever the layout of the tree changes, changing the hashsums
+    static constexpr std::uint32_t VERSION = 1;
+
+    //! How many bytes of input each leaf covers. Part of the layout: changing this changes the hashsums.
+    static constexpr std::size_t LEAF_SIZE = 4096 * Block::BLOCK_SIZE;
+
+    //! How many leaves each thread gets per batch
+    static constexpr std::size_t LEAVES_PER_THREAD = 2;
+
+    //! Will create a hasher that hashes batches of leaves on up to nThreads threads.
+    //! nThreads = 0 uses as many threads as the hardware supports.
+    explicit GTreeHash(std::size_t nThreads = 0);
+
+    //! Will feed n bytes of input to the hash.
+    //! Bytes get buffered until a whole batch of leaves is ready.
+    void Update(const char* bytes, const std::size_t n);
+
+    //! Will feed a string of bytes to the hash
+    void Update(const std::string& bytes);
+
+    //! Will hash the remaining leaves, and join all subtrees to the root.
+    //! Returns the hashsum. No more bytes can be fed afterwards.
+    Block Finalize();
+
+    //! Will calculate the tree hashsum of n bytes, on up to nThreads threads
+    static Block CalculateHashsum(const char* bytes, const std::size_t n, const std::size_t nThreads = 0);
+
+    //! Will calculate the tree hashsum of a string of bytes, on up to nThreads threads
+    static Block CalculateHashsum(const std::string& bytes, const std::size_t nThreads = 0);
+
+    //! Will calculate the tree hashsum of a file, streaming it through batches of leaves
+    static Block HashFile(const std::string& filepath, const std::size_t nThreads = 0);
+
+  private:
+    //! A digest of a complete subtree, covering 2^level leaves
+    struct Subtree {
+      Block digest;
+      std::size_t level;
+    };
+
+    //! Will hash all leaves buffered in the batch, and add them to the tree.
+    //! Only the last leaf may be short, and only when finalizing.
+    void HashBatch();
+
+    //! Will add the digest of the next leaf to the tree, joining complete subtrees of the same size
+    void PushLeaf(const Block& digest);
+
+    std::size_t nThreads;
+
+    //! Input bytes, waiting for a batch of leaves to fill up
+    std::vector<char> batch;
+
+    //! How many bytes of batch are in use
+    std::size_t nBatched = 0;
+
+    //! The index of the next leaf to be hashed
+    std::size_t nLeaves = 0;
+
+    //! How many bytes have been fed in total
+    std::size_t nBytesFed = 0;
+
+    //! Complete subtrees, from left to right. Their levels strictly decrease.
+    std::vector<Subtree> subtrees;
+
+    bool isFinalized = false;
+  };
+}
+
+#endif
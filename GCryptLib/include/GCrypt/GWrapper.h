@@ -3,6 +3,9 @@
 
 #include "GCrypt/Block.h"
 #include "GCrypt/GCipher.h"
+#include "GCrypt/GCounterCipher.h"
+#include "GCrypt/CheckpointIndex.h"
+#include "GCrypt/GCipherState.h"
 #include "GCrypt/Key.h"
 #include <string>
 #include <vector>
@@ -13,28 +16,79 @@ namespace Leonetienne::GCrypt {
   */
   class GWrapper {
   public:
+    //! Describes how blocks get chained together
+    enum class MODE {
+      //! Cipher block chaining, see GCipher
+      CBC,
+
+      //! Counter mode, see GCounterCipher.
+      //! Every encryption uses a fresh random nonce, which leads the ciphertext as its first block.
+      COUNTER
+    };
+
     //! Will encrypt a string and return it hexadecimally encoded.
-    static std::string EncryptString(const std::string& cleartext, const Key& key);
+    static std::string EncryptString(const std::string& cleartext, const Key& key, const MODE mode = MODE::CBC);
 
     //! Will decrypt a hexadecimally encoded string.
-    static std::string DecryptString(const std::string& ciphertext, const Key& key);
+    static std::string DecryptString(const std::string& ciphertext, const Key& key, const MODE mode = MODE::CBC);
 
     //! Will encrypt a file.
     //! Returns false if anything goes wrong (like, file-access).
     //! @filename_in The file to be read.
     //! @filename_out The file the encrypted version should be saved in.
-    static bool EncryptFile(const std::string& filename_in, const std::string& filename_out, const Key& key, bool printProgressReport = false);
+    static bool EncryptFile(const std::string& filename_in, const std::string& filename_out, const Key& key, bool printProgressReport = false, const MODE mode = MODE::CBC);
 
     //! Will decrypt a file.
     //! Returns false if anything goes wrong (like, file-access).
     //! @filename_in The file to be read.
     //! @filename_out The file the decrypted version should be saved in.
-    static bool DecryptFile(const std::string& filename_in, const std::string& filename_out, const Key& key, bool printProgressReport = false);
+    //! In CBC mode, the file gets deciphered on all cores (see ParallelDecipher).
+    //! If it has a checkpoint index (see IndexFile()), every core starts at the nearest checkpoint.
+    static bool DecryptFile(const std::string& filename_in, const std::string& filename_out, const Key& key, bool printProgressReport = false, const MODE mode = MODE::CBC);
+
+    //! Will encrypt a file, and hash the ciphertext in the same pass (see HashingCipher).
+    //! The hashsum equals GHash::CalculateHashsum() of the encrypted file.
+    //! Returns false if anything goes wrong (like, file-access).
+    static bool EncryptAndDigestFile(const std::string& filename_in, const std::string& filename_out, const Key& key, Block& hashsum);
+
+    //! Will decrypt a file, and hash the ciphertext in the same pass (see HashingCipher).
+    //! The decrypted file only gets written if the hashsum matches.
+    //! Returns false if anything goes wrong (like, file-access), or if the hashsum does not match.
+    static bool DecryptAndVerifyFile(const std::string& filename_in, const std::string& filename_out, const Key& key, const Block& hashsum);
+
+    //! Will encrypt a file, and append it to an encrypted file, continuing its CBC chain from `state`.
+    //! Afterwards, `state` is where the encrypted file ends, ready for the next append.
+    //! Decrypting the encrypted file yields all appended files, each padded to full blocks.
+    //! Returns false if anything goes wrong (like, file-access, or a state that deciphers).
+    static bool AppendToEncryptedFile(const std::string& filename_in, const std::string& filename_encrypted, GCipherState& state);
+
+    //! Will reconstruct the state at the end of an encrypted file, for AppendToEncryptedFile().
+    //! If the file has a checkpoint index (see IndexFile()), the key schedule starts at the nearest checkpoint.
+    //! Otherwise it gets rolled from the start of the file.
+    static GCipherState StateAtEndOfFile(const std::string& filename_encrypted, const Key& key);
+
+    //! Will write a checkpoint index for an encrypted file, next to it (see CheckpointIndex::SidecarPath()).
+    //! This allows DecryptRange() to start deciphering anywhere in the file.
+    //! Returns false if anything goes wrong (like, file-access).
+    static bool IndexFile(const std::string& filename_encrypted, const Key& key, const std::size_t interval = CheckpointIndex::DEFAULT_INTERVAL);
+
+    //! Will decrypt `length` bytes of an encrypted file, starting at cleartext byte `offset`.
+    //! Only the blocks covering these bytes get deciphered.
+    //! If the file has a checkpoint index (see IndexFile()), the key schedule starts at the nearest checkpoint.
+    //! Otherwise it gets rolled from the start of the file.
+    //! Files encrypted in COUNTER mode need no index, as any block can be deciphered right away.
+    //! Their leading nonce block does not count towards `offset`.
+    //! The range gets clipped to the end of the file, so `length` may be std::string::npos.
+    static std::string DecryptRange(const std::string& filename_encrypted, const std::size_t offset, const std::size_t length, const Key& key, const MODE mode = MODE::CBC);
 
     //! Will enncrypt or decrypt an entire flexblock of binary data, given a key.
-    static std::vector<Block> CipherBlocks(const std::vector<Block>& data, const Key& key, const GCipher::DIRECTION direction);
+    //! In COUNTER mode, enciphering prepends a random nonce block, and deciphering consumes it.
+    static std::vector<Block> CipherBlocks(const std::vector<Block>& data, const Key& key, const GCipher::DIRECTION direction, const MODE mode = MODE::CBC);
 
   private:
+    //! Will load the checkpoint index of an encrypted file of nBlocks blocks.
+    //! Returns an empty index, if there is none, or if it belongs to a different file.
+    static CheckpointIndex LoadIndexOf(const std::string& filename_encrypted, const std::size_t nBlocks);
 
     // No instanciation! >:(
     GWrapper();
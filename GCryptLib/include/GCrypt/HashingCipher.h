@@ -0,0 +1,96 @@
+#ifndef GCRYPT_HASHINGCIPHER_H
+#define GCRYPT_HASHINGCIPHER_H
+
+#include "GCrypt/GCipher.h"
+#include "GCrypt/GHash.h"
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace Leonetienne::GCrypt {
+  /** A GCipher that hashes the ciphertext going through it, in the same pass.
+  * Enciphering hashes the ciphertext it yields, deciphering hashes the ciphertext it gets.
+  * The hashsum is exactly GHash::CalculateHashsum() of all ciphertext blocks, so it matches
+  * hashing the encrypted file afterwards.
+  *
+  * The cipher and the hash are two independent serial chains. The hash runs on a second thread,
+  * fed through a bounded single-producer/single-consumer queue, so both chains progress at the same time.
+  * Either thread spins for a short while when it has to wait for the other, and then blocks until woken up.
+  *
+  * Mind that GHash has no key. The hashsum protects against corruption, not against someone
+  * who can replace both the ciphertext and the hashsum.
+  */
+  class HashingCipher {
+  public:
+    //! The number of ciphertext blocks that may wait for the hasher
+    static constexpr std::size_t QUEUE_CAPACITY = 256;
+
+    //! How often either thread yields to the other, before blocking
+    static constexpr std::size_t SPINS_BEFORE_BLOCKING = 64;
+
+    //! Will initialize this cipher with a key, and start the hasher
+    HashingCipher(const Key& key, const GCipher::DIRECTION direction);
+
+    HashingCipher(const HashingCipher& other) = delete;
+    HashingCipher(HashingCipher&& other) noexcept = delete;
+    void operator=(const HashingCipher& other) = delete;
+
+    //! Will stop the hasher, if Finish() did not already
+    ~HashingCipher();
+
+    //! Will digest a data block, and return it.
+    //! The ciphertext block gets queued for the hasher.
+    Block Digest(const Block& input);
+
+    //! Will wait for the hasher to catch up, and return the hashsum of all ciphertext digested.
+    //! No more blocks can be digested afterwards.
+    Block Finish();
+
+  private:
+    //! The hasher thread's loop
+    void Hash();
+
+    //! Will wait for a free slot, and queue a ciphertext block
+    void Enqueue(const Block& ciphertext);
+
+    //! Will block the hasher until a block is queued, or no more will be
+    void WaitForBlock(const std::size_t consumed);
+
+    //! Will tell the hasher that no more blocks will get queued, and join it
+    void StopHasher();
+
+    GCipher cipher;
+
+    GCipher::DIRECTION direction;
+
+    //! Only touched by the hasher thread, until it has been joined
+    GHash hasher;
+
+    std::array<Block, QUEUE_CAPACITY> queue;
+
+    //! The number of blocks queued so far. Written by the digesting thread only.
+    alignas(64) std::atomic<std::size_t> head { 0 };
+
+    //! The number of blocks hashed so far. Written by the hasher only.
+    alignas(64) std::atomic<std::size_t> tail { 0 };
+
+    //! Set once no more blocks will get queued
+    alignas(64) std::atomic<bool> finished { false };
+
+    //! Whether either thread is blocked, or about to block, and wants to be woken up
+    std::atomic<bool> digesterBlocked { false };
+    std::atomic<bool> hasherBlocked { false };
+
+    std::mutex mutex;
+    std::condition_variable wakeDigester;
+    std::condition_variable wakeHasher;
+
+    std::thread hasherThread;
+
+    bool isFinished = false;
+  };
+}
+
+#endif
@@ -6,7 +6,34 @@
 #include "GCrypt/Config.h"
 
 namespace Leonetienne::GCrypt {
-  typedef std::array<Key, N_ROUNDS> Keyset;
+  /** The keys for one block of a feistel network.
+  * Holds the round keys, and constants derived from them, so that
+  * the rounds do not have to derive these over and over again.
+  */
+  template <std::size_t Rounds>
+  struct BasicKeyset {
+    //! The round keys, one per feistel round
+    std::array<Key, Rounds> roundKeys;
+
+    //! The round keys, reduced to halfblocks.
+    //! These seal each round.
+    std::array<Halfblock, Rounds> reducedRoundKeys;
+
+    //! Will zero all keys
+    void Reset() {
+      for (Key& key : roundKeys) {
+        key.Reset();
+      }
+
+      for (Halfblock& reducedKey : reducedRoundKeys) {
+        reducedKey.Reset();
+      }
+
+      return;
+    }
+  };
+
+  typedef BasicKeyset<N_ROUNDS> Keyset;
 }
 
 #endif
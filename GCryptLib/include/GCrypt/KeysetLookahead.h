@@ -0,0 +1,93 @@
+#ifndef GCRYPT_KEYSETLOOKAHEAD_H
+#define GCRYPT_KEYSETLOOKAHEAD_H
+
+#include "GCrypt/Feistel.h"
+#include "GCrypt/Keyset.h"
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace Leonetienne::GCrypt {
+  /** Computes the keysets of upcoming blocks ahead of time, on a background thread.
+  * The keyset of a block depends only on the seed-key and the block index, never on the data.
+  * So a producer thread can roll the keysets into a bounded single-producer/single-consumer ring,
+  * while the consuming thread only runs the feistel rounds.
+  * Either side spins for a short while when it has to wait for the other, and then blocks until woken up.
+  * Explicitly instantiated for N_ROUNDS.
+  */
+  template <std::size_t Rounds>
+  class BasicKeysetLookahead {
+  public:
+    //! The number of keysets the producer may compute ahead
+    static constexpr std::size_t CAPACITY = 16;
+
+    //! How often either side yields to the other, before blocking
+    static constexpr std::size_t SPINS_BEFORE_BLOCKING = 64;
+
+    //! Will start computing keysets, beginning with the keyset of the seed-key
+    explicit BasicKeysetLookahead(const Key& seedKey);
+
+    //! Will start computing keysets, beginning with the given keyset
+    explicit BasicKeysetLookahead(const BasicKeyset<Rounds>& first);
+
+    BasicKeysetLookahead(const BasicKeysetLookahead& other) = delete;
+    BasicKeysetLookahead(BasicKeysetLookahead&& other) noexcept = delete;
+    void operator=(const BasicKeysetLookahead& other) = delete;
+
+    //! Will stop the producer, and zero all keysets
+    ~BasicKeysetLookahead();
+
+    //! Will return the keyset of the current block, waiting for it if necessary.
+    //! It stays valid until Pop() gets called.
+    const BasicKeyset<Rounds>& Peek() const;
+
+    //! Will zero the keyset of the current block, and advance to the next one
+    void Pop();
+
+    //! Will discard all keysets computed so far, and continue with the keyset of the seed-key.
+    //! The producer thread keeps running.
+    void Reseed(const Key& seedKey);
+
+    //! Will discard all keysets computed so far, and continue with the given keyset.
+    //! The producer thread keeps running.
+    void Reseed(const BasicKeyset<Rounds>& first);
+
+  private:
+    //! The producer thread's loop
+    void Produce(BasicKeyset<Rounds> next);
+
+    //! Will block the producer until a slot is free, or it has something else to do
+    void WaitForSlot(const std::size_t produced);
+
+    std::array<BasicKeyset<Rounds>, CAPACITY> ring;
+
+    //! The number of keysets produced so far. Written by the producer only.
+    alignas(64) std::atomic<std::size_t> head { 0 };
+
+    //! The number of keysets consumed so far. Written by the consumer only.
+    alignas(64) std::atomic<std::size_t> tail { 0 };
+
+    alignas(64) std::atomic<bool> stop { false };
+
+    //! Set by Reseed(), and cleared by the producer once it continues from pendingSeed
+    std::atomic<bool> reseedRequested { false };
+    BasicKeyset<Rounds> pendingSeed;
+
+    //! Whether either side is blocked, or about to block, and wants to be woken up
+    std::atomic<bool> producerBlocked { false };
+    mutable std::atomic<bool> consumerBlocked { false };
+
+    mutable std::mutex mutex;
+    std::condition_variable wakeProducer;
+    mutable std::condition_variable wakeConsumer;
+
+    std::thread producer;
+  };
+
+  //! The keyset lookahead, as configured in Config.h
+  typedef BasicKeysetLookahead<N_ROUNDS> KeysetLookahead;
+}
+
+#endif
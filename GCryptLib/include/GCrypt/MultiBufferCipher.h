@@ -0,0 +1,75 @@
+#ifndef GCRYPT_MULTIBUFFERCIPHER_H
+#define GCRYPT_MULTIBUFFERCIPHER_H
+
+#include "GCrypt/GCipher.h"
+#include "GCrypt/Keyset.h"
+#include <array>
+#include <cstddef>
+
+namespace Leonetienne::GCrypt {
+  /** Runs Lanes independent CBC streams at once, in the same direction.
+  * Each lane is equivalent to its own GCipher: same key, same initialization vector, same output.
+  * A single stream can only ever digest one block after another, and each block is one long chain
+  * of dependent matrix multiplications. Digesting one block of every lane per call
+  * runs the lanes through each step of the rounds (and of the key schedule) together,
+  * so that the cpu can overlap their chains.
+  *
+  * The stream states are kept as a structure of arrays: all last blocks, all keysets.
+  * Lanes start and end streams independently (see Initialize() and Release()),
+  * so a lane can pick up the next message as soon as its last one is done.
+  *
+  * Explicitly instantiated for 4, 8 and 16 lanes.
+  */
+  template <std::size_t Lanes>
+  class MultiBufferCipher {
+  public:
+    static_assert(Lanes > 0, "A multi-buffer cipher needs at least one lane");
+
+    //! The number of streams this cipher runs at once
+    static constexpr std::size_t LANES = Lanes;
+
+    //! Will create a cipher with all lanes released. Use Initialize() to start streams in them.
+    explicit MultiBufferCipher(const GCipher::DIRECTION direction);
+
+    // Disable copying
+    MultiBufferCipher(const MultiBufferCipher& other) = delete;
+    MultiBufferCipher(MultiBufferCipher&& other) noexcept = delete;
+
+    ~MultiBufferCipher();
+
+    //! Will start a new stream in a lane, as a new GCipher with this key would.
+    //! If the lane holds a stream already, it gets replaced.
+    void Initialize(const std::size_t lane, const Key& key);
+
+    //! Will end the stream in a lane, and wipe its state.
+    //! Digest() leaves released lanes alone.
+    void Release(const std::size_t lane);
+
+    //! Will return whether a lane holds a stream
+    [[nodiscard]] bool IsActive(const std::size_t lane) const;
+
+    //! Will digest the next block of every active lane, in place.
+    //! blocks has to point to Lanes blocks: blocks[i] belongs to lane i.
+    //! The blocks of released lanes stay untouched.
+    void Digest(Block* blocks);
+
+    //! Will digest the next block of every active lane, in place
+    void Digest(std::array<Block, Lanes>& blocks);
+
+  private:
+    //! Will zero the state of a lane
+    void ZeroLaneMemory(const std::size_t lane);
+
+    GCipher::DIRECTION direction;
+
+    //! The ciphertext block each lane chains its next block to
+    std::array<Block, Lanes> lastBlocks;
+
+    //! The keyset each lane digests its next block with
+    std::array<Keyset, Lanes> keysets;
+
+    std::array<bool, Lanes> active;
+  };
+}
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef GCRYPT_PARALLELDECIPHER_H
+#define GCRYPT_PARALLELDECIPHER_H
+
+#include "GCrypt/Block.h"
+#include "GCrypt/CheckpointIndex.h"
+#include "GCrypt/Key.h"
+#include <cstddef>
+#include <vector>
+
+namespace Leonetienne::GCrypt {
+  /** Deciphers CBC ciphertext on multiple threads.
+  * Cleartext block i depends only on ciphertext blocks i and i-1, and on the keyset of block i.
+  * Keysets do not depend on the data, so once the keyset at the start of each range is known,
+  * all ranges of blocks can be deciphered independently.
+  * Yields exactly what a GCipher in DECIPHER direction yields.
+  *
+  * Without a checkpoint index, the keyset gets rolled up to the start of each range on the calling thread, one block at a time.
+  * Rolling a keyset costs about as much as deciphering a block with it, so this serial part caps the speedup at about 2x.
+  * With a checkpoint index, every range gets its keyset from the nearest checkpoint, on its own thread.
+  */
+  class ParallelDecipher {
+  public:
+    //! Will decipher n ciphertext blocks in place, on up to nThreads threads.
+    //! nThreads = 0 uses as many threads as the hardware supports.
+    static void DecipherInplace(Block* blocks, const std::size_t n, const Key& key, std::size_t nThreads = 0);
+
+    //! Will decipher ciphertext blocks in place, on up to nThreads threads.
+    //! nThreads = 0 uses as many threads as the hardware supports.
+    static void DecipherInplace(std::vector<Block>& blocks, const Key& key, const std::size_t nThreads = 0);
+
+    //! Will decipher n ciphertext blocks in place, on up to nThreads threads.
+    //! Every range gets its keyset from the nearest checkpoint of index, which has to belong to key.
+    //! nThreads = 0 uses as many threads as the hardware supports.
+    static void DecipherInplace(Block* blocks, const std::size_t n, const Key& key, const CheckpointIndex& index, std::size_t nThreads = 0);
+
+    //! Will decipher ciphertext blocks in place, on up to nThreads threads.
+    //! Every range gets its keyset from the nearest checkpoint of index, which has to belong to key.
+    //! nThreads = 0 uses as many threads as the hardware supports.
+    static void DecipherInplace(std::vector<Block>& blocks, const Key& key, const CheckpointIndex& index, const std::size_t nThreads = 0);
+
+    //! Ranges get no shorter than this, so that tiny inputs do not pay for threads they do not need
+    static constexpr std::size_t MIN_BLOCKS_PER_THREAD = 64;
+
+  private:
+    // No instanciation! >:(
+    ParallelDecipher();
+  };
+}
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef GCRYPT_SHARDMANIFEST_H
+#define GCRYPT_SHARDMANIFEST_H
+
+#include "GCrypt/Block.h"
+#include "GCrypt/Key.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace Leonetienne::GCrypt {
+  /** Plans the decryption of one encrypted file as independent shards.
+  * Each shard records where it starts, the key schedule state to start with, and the ciphertext block before it.
+  * With the manifest, separate processes can each decrypt one shard into the same, pre-sized output file,
+  * without coordinating with each other.
+  *
+  * The key schedule states are stored as enciphered checkpoints (see CheckpointIndex),
+  * so deciphering a shard still requires the key.
+  */
+  class ShardManifest {
+  public:
+    //! Where a shard starts, and what it needs to start there
+    struct Shard {
+      //! The index of the first block of this shard
+      std::size_t firstBlock = 0;
+
+      //! The number of blocks in this shard
+      std::size_t nBlocks = 0;
+
+      //! The state that rolls into the keyset of firstBlock (see CheckpointIndex::SaveCheckpoint()).
+      //! Unused for the shard starting at block 0, which starts at the key itself.
+      Block checkpoint;
+
+      //! The ciphertext block before firstBlock.
+      //! Unused for the shard starting at block 0, which starts at the initialization vector.
+      Block precedingCiphertext;
+    };
+
+    //! Empty manifest, without any shards
+    ShardManifest();
+
+    //! Will plan the decryption of an encrypted file as up to nShards shards of (about) equal size
+    static ShardManifest Plan(const std::string& filename_encrypted, const Key& key, const std::size_t nShards);
+
+    //! Will return the number of shards
+    std::size_t GetShardCount() const;
+
+    //! Will return a shard
+    const Shard& GetShard(const std::size_t shard) const;
+
+    //! Will return the number of blocks of the whole file
+    std::size_t GetBlockCount() const;
+
+    //! Will create the output file, sized to hold all shards.
+    //! Call this once, before any shard gets decrypted into it.
+    void PrepareOutputFile(const std::string& filename_out) const;
+
+    //! Will decrypt one shard of the encrypted file into its place in the output file.
+    //! Shards can be decrypted in any order, and by different processes.
+    //! Returns false if anything goes wrong (like, file-access).
+    bool DecryptShard(const std::size_t shard, const std::string& filename_encrypted, const std::string& filename_out, const Key& key) const;
+
+    //! Will save the manifest to a file
+    void WriteToFile(const std::string& path) const;
+
+    //! Will load a manifest from a file
+    static ShardManifest LoadFromFile(const std::string& path);
+
+  private:
+    std::size_t nBlocks = 0;
+
+    std::vector<Shard> shards;
+  };
+}
+
+#endif
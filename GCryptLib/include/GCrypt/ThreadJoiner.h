@@ -0,0 +1,53 @@
+#ifndef GCRYPT_THREADJOINER_H
+#define GCRYPT_THREADJOINER_H
+
+#include <cstddef>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace Leonetienne::GCrypt {
+  /** Owns the worker threads of a parallel loop, and joins them, however the loop gets left.
+  * Destroying a joinable std::thread calls std::terminate(). So if spawning a worker fails,
+  * or the share of work done on the calling thread throws, the workers already running still get joined,
+  * and the exception reaches the caller.
+  * This header is internal to GCrypt.
+  */
+  class ThreadJoiner {
+  public:
+    ThreadJoiner() = default;
+
+    ThreadJoiner(const ThreadJoiner& other) = delete;
+    ThreadJoiner(ThreadJoiner&& other) noexcept = delete;
+    void operator=(const ThreadJoiner& other) = delete;
+
+    //! Will join all workers not joined yet
+    ~ThreadJoiner() {
+      Join();
+    }
+
+    //! Will start a worker, running function(args...)
+    template <typename Function, typename... Args>
+    void Spawn(Function&& function, Args&&... args) {
+      workers.emplace_back(std::forward<Function>(function), std::forward<Args>(args)...);
+      return;
+    }
+
+    //! Will wait for all workers to finish
+    void Join() {
+      for (std::thread& worker : workers) {
+        if (worker.joinable()) {
+          worker.join();
+        }
+      }
+      workers.clear();
+
+      return;
+    }
+
+  private:
+    std::vector<std::thread> workers;
+  };
+}
+
+#endif
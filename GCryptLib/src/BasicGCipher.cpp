@@ -0,0 +1,298 @@
+#include "GCrypt/BasicGCipher.h"
+#include "GCrypt/InitializationVector.h"
+#include <algorithm>
+#include <array>
+#include <type_traits>
+
+namespace {
+  // Separates the counter mode stream key from any other use of the key.
+  // Without it, keystream block 0 would equal the CBC encipherment of an all-zero first block.
+  constexpr std::uint32_t STREAM_KEY_DOMAIN = 0x72746E63;
+}
+
+namespace Leonetienne::GCrypt {
+  namespace CipherModes {
+
+    template <std::size_t Rounds>
+    CBC<Rounds>::CBC() {
+    }
+
+    template <std::size_t Rounds>
+    void CBC<Rounds>::Initialize(const Key& key) {
+      feistel.SetKey(key);
+
+      // Initialize our lastBlock with some deterministic initial value, based on the key
+      lastBlock = InitializationVector(key);
+
+      return;
+    }
+
+    template <std::size_t Rounds>
+    void CBC<Rounds>::SetKey(const Key& key) {
+      feistel.SetKey(key);
+      return;
+    }
+
+    template <std::size_t Rounds>
+    template <CIPHER_DIRECTION Direction>
+    Block CBC<Rounds>::Digest(const Block& input) {
+
+      if constexpr (Direction == CIPHER_DIRECTION::ENCIPHER) {
+        // First, xor our cleartext with the last block, and then encipher it
+        lastBlock = feistel.Encipher(input ^ lastBlock);
+        return lastBlock;
+      }
+
+      else {
+        // First, decipher our ciphertext, and then xor it with our last block
+        const Block cleartext = feistel.Decipher(input) ^ lastBlock;
+        lastBlock = input;
+        return cleartext;
+      }
+    }
+
+    template <std::size_t Rounds>
+    template <CIPHER_DIRECTION Direction>
+    Block CBC<Rounds>::Digest(const Block& input, const BasicKeyset<Rounds>& keyset) {
+
+      if constexpr (Direction == CIPHER_DIRECTION::ENCIPHER) {
+        lastBlock = BasicFeistel<Rounds>::Encipher(input ^ lastBlock, keyset);
+        return lastBlock;
+      }
+
+      else {
+        const Block cleartext = BasicFeistel<Rounds>::Decipher(input, keyset) ^ lastBlock;
+        lastBlock = input;
+        return cleartext;
+      }
+    }
+
+    template <std::size_t Rounds>
+    template <std::size_t Lanes>
+    void CBC<Rounds>::Decipher(Block* blocks, const BasicKeyset<Rounds>* const* keysets) {
+      DecipherAndRoll<Lanes>(blocks, keysets, nullptr);
+      return;
+    }
+
+    template <std::size_t Rounds>
+    template <std::size_t Lanes>
+    void CBC<Rounds>::DecipherAndRoll(Block* blocks, const BasicKeyset<Rounds>* const* keysets, BasicKeyset<Rounds>* const* nextKeysets) {
+      // The rounds overwrite the ciphertext, which the chaining still needs
+      std::array<Block, Lanes> ciphertext;
+      std::copy(blocks, blocks + Lanes, ciphertext.begin());
+
+      if (nextKeysets) {
+        BasicFeistel<Rounds>::template DecipherLanesAndRoll<Lanes>(blocks, keysets, nextKeysets);
+      }
+      else {
+        BasicFeistel<Rounds>::template DecipherLanes<Lanes>(blocks, keysets);
+      }
+
+      blocks[0] ^= lastBlock;
+      for (std::size_t i = 1; i < Lanes; i++) {
+        blocks[i] ^= ciphertext[i - 1];
+      }
+      lastBlock = ciphertext.back();
+
+      return;
+    }
+
+    template <std::size_t Rounds>
+    void CBC<Rounds>::DecipherInplace(Block* blocks, const std::size_t n) {
+      std::size_t i = 0;
+
+      if (n >= DECIPHER_LANES) {
+        // Two sets of keysets: the ones of the current run, and the ones of the run after it
+        std::array<std::array<BasicKeyset<Rounds>, DECIPHER_LANES>, 2> keysets;
+        std::array<std::array<BasicKeyset<Rounds>*, DECIPHER_LANES>, 2> keysetPtrs;
+        for (std::size_t k = 0; k < 2; k++) {
+          for (std::size_t j = 0; j < DECIPHER_LANES; j++) {
+            keysetPtrs[k][j] = &keysets[k][j];
+          }
+        }
+        std::size_t current = 0;
+
+        // Only the keysets of the first run get rolled on their own
+        keysets[current][0] = feistel.GetNextKeyset();
+        for (std::size_t j = 1; j < DECIPHER_LANES; j++) {
+          keysets[current][j] = keysets[current][j - 1];
+          BasicFeistel<Rounds>::RollKeyset(keysets[current][j]);
+        }
+
+        // Every other run gets its keysets rolled while the run before it goes through the rounds
+        for (; i + DECIPHER_LANES <= n; i += DECIPHER_LANES) {
+          const std::size_t next = 1 - current;
+          const BasicKeyset<Rounds>* const* currentKeysets = keysetPtrs[current].data();
+
+          if (i + 2 * DECIPHER_LANES <= n) {
+            DecipherAndRoll<DECIPHER_LANES>(blocks + i, currentKeysets, keysetPtrs[next].data());
+          }
+          // The last run only needs the keyset after it
+          else {
+            Decipher<DECIPHER_LANES>(blocks + i, currentKeysets);
+            keysets[next][0] = keysets[current].back();
+            BasicFeistel<Rounds>::RollKeyset(keysets[next][0]);
+          }
+
+          current = next;
+        }
+
+        feistel.SetNextKeyset(keysets[current][0]);
+
+        for (std::array<BasicKeyset<Rounds>, DECIPHER_LANES>& run : keysets) {
+          for (BasicKeyset<Rounds>& keyset : run) {
+            keyset.Reset();
+          }
+        }
+      }
+
+      // Whatever does not fill a whole run
+      for (; i < n; i++) {
+        blocks[i] = Digest<CIPHER_DIRECTION::DECIPHER>(blocks[i]);
+      }
+
+      return;
+    }
+
+    template <std::size_t Rounds>
+    void CBC<Rounds>::ExportState(BasicKeyset<Rounds>& nextKeyset, Block& lastBlock) const {
+      nextKeyset = feistel.GetNextKeyset();
+      lastBlock = this->lastBlock;
+
+      return;
+    }
+
+    template <std::size_t Rounds>
+    void CBC<Rounds>::ImportState(const BasicKeyset<Rounds>& nextKeyset, const Block& lastBlock) {
+      feistel.SetNextKeyset(nextKeyset);
+      this->lastBlock = lastBlock;
+
+      return;
+    }
+
+    template <std::size_t Rounds>
+    Counter<Rounds>::Counter() {
+    }
+
+    template <std::size_t Rounds>
+    Counter<Rounds>::~Counter() {
+      // Clear key material
+      keyset.Reset();
+      return;
+    }
+
+    template <std::size_t Rounds>
+    void Counter<Rounds>::Initialize(const Key& key, const Block& nonce) {
+      // Derive the stream key, by enciphering a tag under the key
+      Block tag;
+      tag.Reset();
+      tag[0] = STREAM_KEY_DOMAIN;
+
+      BasicFeistel<Rounds>::GenerateKeyset(keyset, key);
+      Key streamKey(BasicFeistel<Rounds>::Encipher(tag, keyset));
+      BasicFeistel<Rounds>::GenerateKeyset(keyset, streamKey);
+      streamKey.Reset();
+
+      this->nonce = nonce;
+      position = 0;
+
+      return;
+    }
+
+    template <std::size_t Rounds>
+    template <CIPHER_DIRECTION Direction>
+    Block Counter<Rounds>::Digest(const Block& input) {
+      return input ^ KeystreamBlock(position++);
+    }
+
+    template <std::size_t Rounds>
+    Block Counter<Rounds>::KeystreamBlock(const std::size_t i) const {
+      // The counter goes into the last two cells of the nonce
+      Block counter = nonce;
+      counter[14] ^= (std::uint32_t)(i & 0xFFFFFFFF);
+      counter[15] ^= (std::uint32_t)((std::uint64_t)i >> 32);
+
+      return BasicFeistel<Rounds>::Encipher(counter, keyset);
+    }
+
+    template <std::size_t Rounds>
+    void Counter<Rounds>::Seek(const std::size_t blockIndex) {
+      position = blockIndex;
+      return;
+    }
+
+    template <std::size_t Rounds>
+    std::size_t Counter<Rounds>::GetPosition() const {
+      return position;
+    }
+
+  }
+
+  template <template <std::size_t> class Mode, CIPHER_DIRECTION Direction, std::size_t Rounds>
+  template <typename M, typename>
+  BasicGCipher<Mode, Direction, Rounds>::BasicGCipher(const Key& key) {
+    mode.Initialize(key);
+    return;
+  }
+
+  template <template <std::size_t> class Mode, CIPHER_DIRECTION Direction, std::size_t Rounds>
+  template <typename M, typename>
+  BasicGCipher<Mode, Direction, Rounds>::BasicGCipher(const Key& key, const Block& nonce) {
+    mode.Initialize(key, nonce);
+    return;
+  }
+
+  template <template <std::size_t> class Mode, CIPHER_DIRECTION Direction, std::size_t Rounds>
+  Block BasicGCipher<Mode, Direction, Rounds>::Digest(const Block& input) {
+    return mode.template Digest<Direction>(input);
+  }
+
+  template <template <std::size_t> class Mode, CIPHER_DIRECTION Direction, std::size_t Rounds>
+  void BasicGCipher<Mode, Direction, Rounds>::DigestInplace(Block* blocks, const std::size_t n) {
+    // CBC deciphers runs of consecutive blocks side by side
+    if constexpr ((Direction == CIPHER_DIRECTION::DECIPHER) && (std::is_same_v<Mode<Rounds>, CipherModes::CBC<Rounds>>)) {
+      mode.DecipherInplace(blocks, n);
+      return;
+    }
+
+    for (std::size_t i = 0; i < n; i++) {
+      blocks[i] = mode.template Digest<Direction>(blocks[i]);
+    }
+
+    return;
+  }
+
+  template <template <std::size_t> class Mode, CIPHER_DIRECTION Direction, std::size_t Rounds>
+  void BasicGCipher<Mode, Direction, Rounds>::DigestInplace(std::vector<Block>& blocks) {
+    DigestInplace(blocks.data(), blocks.size());
+    return;
+  }
+
+  template <template <std::size_t> class Mode, CIPHER_DIRECTION Direction, std::size_t Rounds>
+  Mode<Rounds>& BasicGCipher<Mode, Direction, Rounds>::GetMode() {
+    return mode;
+  }
+
+  // Instantiate templates
+  template class CipherModes::CBC<N_ROUNDS>;
+  template Block CipherModes::CBC<N_ROUNDS>::Digest<CIPHER_DIRECTION::ENCIPHER>(const Block&);
+  template Block CipherModes::CBC<N_ROUNDS>::Digest<CIPHER_DIRECTION::DECIPHER>(const Block&);
+  template Block CipherModes::CBC<N_ROUNDS>::Digest<CIPHER_DIRECTION::ENCIPHER>(const Block&, const BasicKeyset<N_ROUNDS>&);
+  template Block CipherModes::CBC<N_ROUNDS>::Digest<CIPHER_DIRECTION::DECIPHER>(const Block&, const BasicKeyset<N_ROUNDS>&);
+  template void CipherModes::CBC<N_ROUNDS>::Decipher<4>(Block*, const BasicKeyset<N_ROUNDS>* const*);
+  template void CipherModes::CBC<N_ROUNDS>::Decipher<8>(Block*, const BasicKeyset<N_ROUNDS>* const*);
+  template void CipherModes::CBC<N_ROUNDS>::Decipher<16>(Block*, const BasicKeyset<N_ROUNDS>* const*);
+
+  template class CipherModes::Counter<N_ROUNDS>;
+  template Block CipherModes::Counter<N_ROUNDS>::Digest<CIPHER_DIRECTION::ENCIPHER>(const Block&);
+  template Block CipherModes::Counter<N_ROUNDS>::Digest<CIPHER_DIRECTION::DECIPHER>(const Block&);
+
+  template class BasicGCipher<CipherModes::CBC, CIPHER_DIRECTION::ENCIPHER, N_ROUNDS>;
+  template class BasicGCipher<CipherModes::CBC, CIPHER_DIRECTION::DECIPHER, N_ROUNDS>;
+  template class BasicGCipher<CipherModes::Counter, CIPHER_DIRECTION::ENCIPHER, N_ROUNDS>;
+  template class BasicGCipher<CipherModes::Counter, CIPHER_DIRECTION::DECIPHER, N_ROUNDS>;
+  template BasicGCipher<CipherModes::CBC, CIPHER_DIRECTION::ENCIPHER, N_ROUNDS>::BasicGCipher(const Key&);
+  template BasicGCipher<CipherModes::CBC, CIPHER_DIRECTION::DECIPHER, N_ROUNDS>::BasicGCipher(const Key&);
+  template BasicGCipher<CipherModes::Counter, CIPHER_DIRECTION::ENCIPHER, N_ROUNDS>::BasicGCipher(const Key&, const Block&);
+  template BasicGCipher<CipherModes::Counter, CIPHER_DIRECTION::DECIPHER, N_ROUNDS>::BasicGCipher(const Key&, const Block&);
+}
@@ -1,4 +1,5 @@
 #include "GCrypt/Block.h"
+#include "GCrypt/BlockKernels.h"
 #include "GCrypt/Config.h"
 #include "GCrypt/Util.h"
 #include <sstream>
@@ -147,6 +148,13 @@ namespace Leonetienne::GCrypt {
 
   template <typename T>
   Basic_Block<T> Basic_Block<T>::MMul(const Basic_Block<T>& o) const {
+    Basic_Block<T> m;
+    Kernels::MMul(m.data.data(), data.data(), o.data.data());
+    return m;
+  }
+
+  template <typename T>
+  Basic_Block<T> Basic_Block<T>::MMulScalar(const Basic_Block<T>& o) const {
 
     Basic_Block<T> m;
 
@@ -182,31 +190,7 @@ namespace Leonetienne::GCrypt {
 
   template <typename T>
   void Basic_Block<T>::MMulInplace(const Basic_Block<T>& o) {
-
-    Basic_Block<T> m = *this;
-
-    // Maybe pre-calculate the 1d-index...?
-
-    this->Get(MAT_INDEX(0, 0)) = (m.Get(MAT_INDEX(0, 0)) * o.Get(MAT_INDEX(0, 0))) + (m.Get(MAT_INDEX(0, 1)) * o.Get(MAT_INDEX(1, 0))) + (m.Get(MAT_INDEX(0, 2)) * o.Get(MAT_INDEX(2, 0))) + (m.Get(MAT_INDEX(0, 3)) * o.Get(MAT_INDEX(3, 0)));
-    this->Get(MAT_INDEX(0, 1)) = (m.Get(MAT_INDEX(0, 0)) * o.Get(MAT_INDEX(0, 1))) + (m.Get(MAT_INDEX(0, 1)) * o.Get(MAT_INDEX(1, 1))) + (m.Get(MAT_INDEX(0, 2)) * o.Get(MAT_INDEX(2, 1))) + (m.Get(MAT_INDEX(0, 3)) * o.Get(MAT_INDEX(3, 1)));
-    this->Get(MAT_INDEX(0, 2)) = (m.Get(MAT_INDEX(0, 0)) * o.Get(MAT_INDEX(0, 2))) + (m.Get(MAT_INDEX(0, 1)) * o.Get(MAT_INDEX(1, 2))) + (m.Get(MAT_INDEX(0, 2)) * o.Get(MAT_INDEX(2, 2))) + (m.Get(MAT_INDEX(0, 3)) * o.Get(MAT_INDEX(3, 2)));
-    this->Get(MAT_INDEX(0, 3)) = (m.Get(MAT_INDEX(0, 0)) * o.Get(MAT_INDEX(0, 3))) + (m.Get(MAT_INDEX(0, 1)) * o.Get(MAT_INDEX(1, 3))) + (m.Get(MAT_INDEX(0, 2)) * o.Get(MAT_INDEX(2, 3))) + (m.Get(MAT_INDEX(0, 3)) * o.Get(MAT_INDEX(3, 3)));
-
-    this->Get(MAT_INDEX(1, 0)) = (m.Get(MAT_INDEX(1, 0)) * o.Get(MAT_INDEX(0, 0))) + (m.Get(MAT_INDEX(1, 1)) * o.Get(MAT_INDEX(1, 0))) + (m.Get(MAT_INDEX(1, 2)) * o.Get(MAT_INDEX(2, 0))) + (m.Get(MAT_INDEX(1, 3)) * o.Get(MAT_INDEX(3, 0)));
-    this->Get(MAT_INDEX(1, 1)) = (m.Get(MAT_INDEX(1, 0)) * o.Get(MAT_INDEX(0, 1))) + (m.Get(MAT_INDEX(1, 1)) * o.Get(MAT_INDEX(1, 1))) + (m.Get(MAT_INDEX(1, 2)) * o.Get(MAT_INDEX(2, 1))) + (m.Get(MAT_INDEX(1, 3)) * o.Get(MAT_INDEX(3, 1)));
-    this->Get(MAT_INDEX(1, 2)) = (m.Get(MAT_INDEX(1, 0)) * o.Get(MAT_INDEX(0, 2))) + (m.Get(MAT_INDEX(1, 1)) * o.Get(MAT_INDEX(1, 2))) + (m.Get(MAT_INDEX(1, 2)) * o.Get(MAT_INDEX(2, 2))) + (m.Get(MAT_INDEX(1, 3)) * o.Get(MAT_INDEX(3, 2)));
-    this->Get(MAT_INDEX(1, 3)) = (m.Get(MAT_INDEX(1, 0)) * o.Get(MAT_INDEX(0, 3))) + (m.Get(MAT_INDEX(1, 1)) * o.Get(MAT_INDEX(1, 3))) + (m.Get(MAT_INDEX(1, 2)) * o.Get(MAT_INDEX(2, 3))) + (m.Get(MAT_INDEX(1, 3)) * o.Get(MAT_INDEX(3, 3)));
-
-    this->Get(MAT_INDEX(2, 0)) = (m.Get(MAT_INDEX(2, 0)) * o.Get(MAT_INDEX(0, 0))) + (m.Get(MAT_INDEX(2, 1)) * o.Get(MAT_INDEX(1, 0))) + (m.Get(MAT_INDEX(2, 2)) * o.Get(MAT_INDEX(2, 0))) + (m.Get(MAT_INDEX(2, 3)) * o.Get(MAT_INDEX(3, 0)));
-    this->Get(MAT_INDEX(2, 1)) = (m.Get(MAT_INDEX(2, 0)) * o.Get(MAT_INDEX(0, 1))) + (m.Get(MAT_INDEX(2, 1)) * o.Get(MAT_INDEX(1, 1))) + (m.Get(MAT_INDEX(2, 2)) * o.Get(MAT_INDEX(2, 1))) + (m.Get(MAT_INDEX(2, 3)) * o.Get(MAT_INDEX(3, 1)));
-    this->Get(MAT_INDEX(2, 2)) = (m.Get(MAT_INDEX(2, 0)) * o.Get(MAT_INDEX(0, 2))) + (m.Get(MAT_INDEX(2, 1)) * o.Get(MAT_INDEX(1, 2))) + (m.Get(MAT_INDEX(2, 2)) * o.Get(MAT_INDEX(2, 2))) + (m.Get(MAT_INDEX(2, 3)) * o.Get(MAT_INDEX(3, 2)));
-    this->Get(MAT_INDEX(2, 3)) = (m.Get(MAT_INDEX(2, 0)) * o.Get(MAT_INDEX(0, 3))) + (m.Get(MAT_INDEX(2, 1)) * o.Get(MAT_INDEX(1, 3))) + (m.Get(MAT_INDEX(2, 2)) * o.Get(MAT_INDEX(2, 3))) + (m.Get(MAT_INDEX(2, 3)) * o.Get(MAT_INDEX(3, 3)));
-
-    this->Get(MAT_INDEX(3, 0)) = (m.Get(MAT_INDEX(3, 0)) * o.Get(MAT_INDEX(0, 0))) + (m.Get(MAT_INDEX(3, 1)) * o.Get(MAT_INDEX(1, 0))) + (m.Get(MAT_INDEX(3, 2)) * o.Get(MAT_INDEX(2, 0))) + (m.Get(MAT_INDEX(3, 3)) * o.Get(MAT_INDEX(3, 0)));
-    this->Get(MAT_INDEX(3, 1)) = (m.Get(MAT_INDEX(3, 0)) * o.Get(MAT_INDEX(0, 1))) + (m.Get(MAT_INDEX(3, 1)) * o.Get(MAT_INDEX(1, 1))) + (m.Get(MAT_INDEX(3, 2)) * o.Get(MAT_INDEX(2, 1))) + (m.Get(MAT_INDEX(3, 3)) * o.Get(MAT_INDEX(3, 1)));
-    this->Get(MAT_INDEX(3, 2)) = (m.Get(MAT_INDEX(3, 0)) * o.Get(MAT_INDEX(0, 2))) + (m.Get(MAT_INDEX(3, 1)) * o.Get(MAT_INDEX(1, 2))) + (m.Get(MAT_INDEX(3, 2)) * o.Get(MAT_INDEX(2, 2))) + (m.Get(MAT_INDEX(3, 3)) * o.Get(MAT_INDEX(3, 2)));
-    this->Get(MAT_INDEX(3, 3)) = (m.Get(MAT_INDEX(3, 0)) * o.Get(MAT_INDEX(0, 3))) + (m.Get(MAT_INDEX(3, 1)) * o.Get(MAT_INDEX(1, 3))) + (m.Get(MAT_INDEX(3, 2)) * o.Get(MAT_INDEX(2, 3))) + (m.Get(MAT_INDEX(3, 3)) * o.Get(MAT_INDEX(3, 3)));
-
+    Kernels::MMul(data.data(), data.data(), o.data.data());
     return;
   }
 
@@ -218,11 +202,8 @@ namespace Leonetienne::GCrypt {
 
   template <typename T>
   Basic_Block<T> Basic_Block<T>::Xor(const Basic_Block<T>& other) const {
-
     Basic_Block<T> m;
-    for (std::size_t i = 0; i < data.size(); i++) {
-      m.Get(i) = this->Get(i) ^ other.Get(i);
-    }
+    Kernels::Xor(m.data.data(), data.data(), other.data.data());
     return m;
   }
 
@@ -233,9 +214,7 @@ namespace Leonetienne::GCrypt {
 
   template <typename T>
   void Basic_Block<T>::XorInplace(const Basic_Block<T>& other) {
-    for (std::size_t i = 0; i < data.size(); i++) {
-      this->Get(i) ^= other.Get(i);
-    }
+    Kernels::Xor(data.data(), data.data(), other.data.data());
     return;
   }
 
@@ -247,11 +226,8 @@ namespace Leonetienne::GCrypt {
 
   template <typename T>
   Basic_Block<T> Basic_Block<T>::Add(const Basic_Block<T>& other) const {
-
     Basic_Block<T> m;
-    for (std::size_t i = 0; i < data.size(); i++) {
-      m.Get(i) = this->Get(i) + other.Get(i);
-    }
+    Kernels::Add(m.data.data(), data.data(), other.data.data());
     return m;
   }
 
@@ -262,9 +238,7 @@ namespace Leonetienne::GCrypt {
 
   template <typename T>
   void Basic_Block<T>::AddInplace(const Basic_Block<T>& other) {
-    for (std::size_t i = 0; i < data.size(); i++) {
-      this->Get(i) += other.Get(i);
-    }
+    Kernels::Add(data.data(), data.data(), other.data.data());
     return;
   }
 
@@ -276,11 +250,8 @@ namespace Leonetienne::GCrypt {
 
   template <typename T>
   Basic_Block<T> Basic_Block<T>::Sub(const Basic_Block<T>& other) const {
-
     Basic_Block<T> m;
-    for (std::size_t i = 0; i < data.size(); i++) {
-      m.Get(i) = this->Get(i) - other.Get(i);
-    }
+    Kernels::Sub(m.data.data(), data.data(), other.data.data());
     return m;
   }
 
@@ -291,9 +262,7 @@ namespace Leonetienne::GCrypt {
 
   template <typename T>
   void Basic_Block<T>::SubInplace(const Basic_Block<T>& other) {
-    for (std::size_t i = 0; i < data.size(); i++) {
-      this->Get(i) -= other.Get(i);
-    }
+    Kernels::Sub(data.data(), data.data(), other.data.data());
     return;
   }
 
@@ -304,271 +273,82 @@ namespace Leonetienne::GCrypt {
   }
 
   template <typename T>
-  void Basic_Block<T>::ShiftRowsUpInplace() {
-    Basic_Block<T> tmp = *this;
-
-    Get(MAT_INDEX(0, 0)) = tmp.Get(MAT_INDEX(1, 0));
-    Get(MAT_INDEX(0, 1)) = tmp.Get(MAT_INDEX(1, 1));
-    Get(MAT_INDEX(0, 2)) = tmp.Get(MAT_INDEX(1, 2));
-    Get(MAT_INDEX(0, 3)) = tmp.Get(MAT_INDEX(1, 3));
-
-    Get(MAT_INDEX(1, 0)) = tmp.Get(MAT_INDEX(2, 0));
-    Get(MAT_INDEX(1, 1)) = tmp.Get(MAT_INDEX(2, 1));
-    Get(MAT_INDEX(1, 2)) = tmp.Get(MAT_INDEX(2, 2));
-    Get(MAT_INDEX(1, 3)) = tmp.Get(MAT_INDEX(2, 3));
-
-    Get(MAT_INDEX(2, 0)) = tmp.Get(MAT_INDEX(3, 0));
-    Get(MAT_INDEX(2, 1)) = tmp.Get(MAT_INDEX(3, 1));
-    Get(MAT_INDEX(2, 2)) = tmp.Get(MAT_INDEX(3, 2));
-    Get(MAT_INDEX(2, 3)) = tmp.Get(MAT_INDEX(3, 3));
+  Basic_Block<T> Basic_Block<T>::Permute(const BlockPermutation& permutation) const {
+    Basic_Block<T> b;
+    Kernels::PermuteCells(b.data.data(), data.data(), permutation.Data());
+    return b;
+  }
 
-    Get(MAT_INDEX(3, 0)) = tmp.Get(MAT_INDEX(0, 0));
-    Get(MAT_INDEX(3, 1)) = tmp.Get(MAT_INDEX(0, 1));
-    Get(MAT_INDEX(3, 2)) = tmp.Get(MAT_INDEX(0, 2));
-    Get(MAT_INDEX(3, 3)) = tmp.Get(MAT_INDEX(0, 3));
+  template <typename T>
+  void Basic_Block<T>::PermuteInplace(const BlockPermutation& permutation) {
+    Kernels::PermuteCells(data.data(), data.data(), permutation.Data());
+    return;
+  }
 
+  template <typename T>
+  void Basic_Block<T>::ShiftRowsUpInplace() {
+    PermuteInplace(BlockPermutation::ShiftRowsUp());
     return;
   }
 
   template <typename T>
   Basic_Block<T> Basic_Block<T>::ShiftRowsUp() const {
-    Basic_Block<T> b;
-
-    b.Get(MAT_INDEX(0, 0)) = Get(MAT_INDEX(1, 0));
-    b.Get(MAT_INDEX(0, 1)) = Get(MAT_INDEX(1, 1));
-    b.Get(MAT_INDEX(0, 2)) = Get(MAT_INDEX(1, 2));
-    b.Get(MAT_INDEX(0, 3)) = Get(MAT_INDEX(1, 3));
-
-    b.Get(MAT_INDEX(1, 0)) = Get(MAT_INDEX(2, 0));
-    b.Get(MAT_INDEX(1, 1)) = Get(MAT_INDEX(2, 1));
-    b.Get(MAT_INDEX(1, 2)) = Get(MAT_INDEX(2, 2));
-    b.Get(MAT_INDEX(1, 3)) = Get(MAT_INDEX(2, 3));
-
-    b.Get(MAT_INDEX(2, 0)) = Get(MAT_INDEX(3, 0));
-    b.Get(MAT_INDEX(2, 1)) = Get(MAT_INDEX(3, 1));
-    b.Get(MAT_INDEX(2, 2)) = Get(MAT_INDEX(3, 2));
-    b.Get(MAT_INDEX(2, 3)) = Get(MAT_INDEX(3, 3));
-
-    b.Get(MAT_INDEX(3, 0)) = Get(MAT_INDEX(0, 0));
-    b.Get(MAT_INDEX(3, 1)) = Get(MAT_INDEX(0, 1));
-    b.Get(MAT_INDEX(3, 2)) = Get(MAT_INDEX(0, 2));
-    b.Get(MAT_INDEX(3, 3)) = Get(MAT_INDEX(0, 3));
-
-    return b;
+    return Permute(BlockPermutation::ShiftRowsUp());
   }
 
   template <typename T>
   void Basic_Block<T>::ShiftRowsDownInplace() {
-    Basic_Block<T> tmp = *this;
-
-    Get(MAT_INDEX(0, 0)) = tmp.Get(MAT_INDEX(3, 0));
-    Get(MAT_INDEX(0, 1)) = tmp.Get(MAT_INDEX(3, 1));
-    Get(MAT_INDEX(0, 2)) = tmp.Get(MAT_INDEX(3, 2));
-    Get(MAT_INDEX(0, 3)) = tmp.Get(MAT_INDEX(3, 3));
-
-    Get(MAT_INDEX(1, 0)) = tmp.Get(MAT_INDEX(0, 0));
-    Get(MAT_INDEX(1, 1)) = tmp.Get(MAT_INDEX(0, 1));
-    Get(MAT_INDEX(1, 2)) = tmp.Get(MAT_INDEX(0, 2));
-    Get(MAT_INDEX(1, 3)) = tmp.Get(MAT_INDEX(0, 3));
-
-    Get(MAT_INDEX(2, 0)) = tmp.Get(MAT_INDEX(1, 0));
-    Get(MAT_INDEX(2, 1)) = tmp.Get(MAT_INDEX(1, 1));
-    Get(MAT_INDEX(2, 2)) = tmp.Get(MAT_INDEX(1, 2));
-    Get(MAT_INDEX(2, 3)) = tmp.Get(MAT_INDEX(1, 3));
-
-    Get(MAT_INDEX(3, 0)) = tmp.Get(MAT_INDEX(2, 0));
-    Get(MAT_INDEX(3, 1)) = tmp.Get(MAT_INDEX(2, 1));
-    Get(MAT_INDEX(3, 2)) = tmp.Get(MAT_INDEX(2, 2));
-    Get(MAT_INDEX(3, 3)) = tmp.Get(MAT_INDEX(2, 3));
-
+    PermuteInplace(BlockPermutation::ShiftRowsDown());
     return;
   }
 
   template <typename T>
   Basic_Block<T> Basic_Block<T>::ShiftRowsDown() const {
-    Basic_Block<T> b;
-
-    b.Get(MAT_INDEX(0, 0)) = Get(MAT_INDEX(3, 0));
-    b.Get(MAT_INDEX(0, 1)) = Get(MAT_INDEX(3, 1));
-    b.Get(MAT_INDEX(0, 2)) = Get(MAT_INDEX(3, 2));
-    b.Get(MAT_INDEX(0, 3)) = Get(MAT_INDEX(3, 3));
-
-    b.Get(MAT_INDEX(1, 0)) = Get(MAT_INDEX(0, 0));
-    b.Get(MAT_INDEX(1, 1)) = Get(MAT_INDEX(0, 1));
-    b.Get(MAT_INDEX(1, 2)) = Get(MAT_INDEX(0, 2));
-    b.Get(MAT_INDEX(1, 3)) = Get(MAT_INDEX(0, 3));
-
-    b.Get(MAT_INDEX(2, 0)) = Get(MAT_INDEX(1, 0));
-    b.Get(MAT_INDEX(2, 1)) = Get(MAT_INDEX(1, 1));
-    b.Get(MAT_INDEX(2, 2)) = Get(MAT_INDEX(1, 2));
-    b.Get(MAT_INDEX(2, 3)) = Get(MAT_INDEX(1, 3));
-
-    b.Get(MAT_INDEX(3, 0)) = Get(MAT_INDEX(2, 0));
-    b.Get(MAT_INDEX(3, 1)) = Get(MAT_INDEX(2, 1));
-    b.Get(MAT_INDEX(3, 2)) = Get(MAT_INDEX(2, 2));
-    b.Get(MAT_INDEX(3, 3)) = Get(MAT_INDEX(2, 3));
-
-    return b;
+    return Permute(BlockPermutation::ShiftRowsDown());
   }
 
   template <typename T>
   void Basic_Block<T>::ShiftColumnsLeftInplace() {
-    Basic_Block<T> tmp = *this;
-
-    Get(MAT_INDEX(0, 0)) = tmp.Get(MAT_INDEX(0, 1));
-    Get(MAT_INDEX(1, 0)) = tmp.Get(MAT_INDEX(1, 1));
-    Get(MAT_INDEX(2, 0)) = tmp.Get(MAT_INDEX(2, 1));
-    Get(MAT_INDEX(3, 0)) = tmp.Get(MAT_INDEX(3, 1));
-
-    Get(MAT_INDEX(0, 1)) = tmp.Get(MAT_INDEX(0, 2));
-    Get(MAT_INDEX(1, 1)) = tmp.Get(MAT_INDEX(1, 2));
-    Get(MAT_INDEX(2, 1)) = tmp.Get(MAT_INDEX(2, 2));
-    Get(MAT_INDEX(3, 1)) = tmp.Get(MAT_INDEX(3, 2));
-
-    Get(MAT_INDEX(0, 2)) = tmp.Get(MAT_INDEX(0, 3));
-    Get(MAT_INDEX(1, 2)) = tmp.Get(MAT_INDEX(1, 3));
-    Get(MAT_INDEX(2, 2)) = tmp.Get(MAT_INDEX(2, 3));
-    Get(MAT_INDEX(3, 2)) = tmp.Get(MAT_INDEX(3, 3));
-
-    Get(MAT_INDEX(0, 3)) = tmp.Get(MAT_INDEX(0, 0));
-    Get(MAT_INDEX(1, 3)) = tmp.Get(MAT_INDEX(1, 0));
-    Get(MAT_INDEX(2, 3)) = tmp.Get(MAT_INDEX(2, 0));
-    Get(MAT_INDEX(3, 3)) = tmp.Get(MAT_INDEX(3, 0));
-
+    PermuteInplace(BlockPermutation::ShiftColumnsLeft());
     return;
   }
 
   template <typename T>
   Basic_Block<T> Basic_Block<T>::ShiftColumnsLeft() const {
-    Basic_Block<T> b;
-
-    b.Get(MAT_INDEX(0, 0)) = Get(MAT_INDEX(0, 1));
-    b.Get(MAT_INDEX(1, 0)) = Get(MAT_INDEX(1, 1));
-    b.Get(MAT_INDEX(2, 0)) = Get(MAT_INDEX(2, 1));
-    b.Get(MAT_INDEX(3, 0)) = Get(MAT_INDEX(3, 1));
-
-    b.Get(MAT_INDEX(0, 1)) = Get(MAT_INDEX(0, 2));
-    b.Get(MAT_INDEX(1, 1)) = Get(MAT_INDEX(1, 2));
-    b.Get(MAT_INDEX(2, 1)) = Get(MAT_INDEX(2, 2));
-    b.Get(MAT_INDEX(3, 1)) = Get(MAT_INDEX(3, 2));
-
-    b.Get(MAT_INDEX(0, 2)) = Get(MAT_INDEX(0, 3));
-    b.Get(MAT_INDEX(1, 2)) = Get(MAT_INDEX(1, 3));
-    b.Get(MAT_INDEX(2, 2)) = Get(MAT_INDEX(2, 3));
-    b.Get(MAT_INDEX(3, 2)) = Get(MAT_INDEX(3, 3));
-
-    b.Get(MAT_INDEX(0, 3)) = Get(MAT_INDEX(0, 0));
-    b.Get(MAT_INDEX(1, 3)) = Get(MAT_INDEX(1, 0));
-    b.Get(MAT_INDEX(2, 3)) = Get(MAT_INDEX(2, 0));
-    b.Get(MAT_INDEX(3, 3)) = Get(MAT_INDEX(3, 0));
-
-    return b;
+    return Permute(BlockPermutation::ShiftColumnsLeft());
   }
 
   template <typename T>
   void Basic_Block<T>::ShiftColumnsRightInplace() {
-    Basic_Block<T> tmp = *this;
-
-    Get(MAT_INDEX(0, 1)) = tmp.Get(MAT_INDEX(0, 0));
-    Get(MAT_INDEX(1, 1)) = tmp.Get(MAT_INDEX(1, 0));
-    Get(MAT_INDEX(2, 1)) = tmp.Get(MAT_INDEX(2, 0));
-    Get(MAT_INDEX(3, 1)) = tmp.Get(MAT_INDEX(3, 0));
-
-    Get(MAT_INDEX(0, 2)) = tmp.Get(MAT_INDEX(0, 1));
-    Get(MAT_INDEX(1, 2)) = tmp.Get(MAT_INDEX(1, 1));
-    Get(MAT_INDEX(2, 2)) = tmp.Get(MAT_INDEX(2, 1));
-    Get(MAT_INDEX(3, 2)) = tmp.Get(MAT_INDEX(3, 1));
-
-    Get(MAT_INDEX(0, 3)) = tmp.Get(MAT_INDEX(0, 2));
-    Get(MAT_INDEX(1, 3)) = tmp.Get(MAT_INDEX(1, 2));
-    Get(MAT_INDEX(2, 3)) = tmp.Get(MAT_INDEX(2, 2));
-    Get(MAT_INDEX(3, 3)) = tmp.Get(MAT_INDEX(3, 2));
-
-    Get(MAT_INDEX(0, 0)) = tmp.Get(MAT_INDEX(0, 3));
-    Get(MAT_INDEX(1, 0)) = tmp.Get(MAT_INDEX(1, 3));
-    Get(MAT_INDEX(2, 0)) = tmp.Get(MAT_INDEX(2, 3));
-    Get(MAT_INDEX(3, 0)) = tmp.Get(MAT_INDEX(3, 3));
-
+    PermuteInplace(BlockPermutation::ShiftColumnsRight());
     return;
   }
 
   template <typename T>
   Basic_Block<T> Basic_Block<T>::ShiftColumnsRight() const {
-    Basic_Block<T> b;
-
-    b.Get(MAT_INDEX(0, 1)) = Get(MAT_INDEX(0, 0));
-    b.Get(MAT_INDEX(1, 1)) = Get(MAT_INDEX(1, 0));
-    b.Get(MAT_INDEX(2, 1)) = Get(MAT_INDEX(2, 0));
-    b.Get(MAT_INDEX(3, 1)) = Get(MAT_INDEX(3, 0));
-
-    b.Get(MAT_INDEX(0, 2)) = Get(MAT_INDEX(0, 1));
-    b.Get(MAT_INDEX(1, 2)) = Get(MAT_INDEX(1, 1));
-    b.Get(MAT_INDEX(2, 2)) = Get(MAT_INDEX(2, 1));
-    b.Get(MAT_INDEX(3, 2)) = Get(MAT_INDEX(3, 1));
-
-    b.Get(MAT_INDEX(0, 3)) = Get(MAT_INDEX(0, 2));
-    b.Get(MAT_INDEX(1, 3)) = Get(MAT_INDEX(1, 2));
-    b.Get(MAT_INDEX(2, 3)) = Get(MAT_INDEX(2, 2));
-    b.Get(MAT_INDEX(3, 3)) = Get(MAT_INDEX(3, 2));
-
-    b.Get(MAT_INDEX(0, 0)) = Get(MAT_INDEX(0, 3));
-    b.Get(MAT_INDEX(1, 0)) = Get(MAT_INDEX(1, 3));
-    b.Get(MAT_INDEX(2, 0)) = Get(MAT_INDEX(2, 3));
-    b.Get(MAT_INDEX(3, 0)) = Get(MAT_INDEX(3, 3));
-
-    return b;
+    return Permute(BlockPermutation::ShiftColumnsRight());
   }
 
   template <typename T>
   void Basic_Block<T>::ShiftCellsLeftInplace() {
-    Basic_Block<T> tmp = *this;
-
-    Get(15) = tmp.Get(0);
-
-    for (std::size_t i = 0; i < 15; i++) {
-      Get(i) = tmp.Get(i+1);
-    }
-
+    PermuteInplace(BlockPermutation::ShiftCellsLeft());
     return;
   }
 
   template <typename T>
   Basic_Block<T> Basic_Block<T>::ShiftCellsLeft() const {
-    Basic_Block<T> b;
-
-    b.Get(15) = Get(0);
-
-    for (std::size_t i = 0; i < 15; i++) {
-      b.Get(i) = Get(i+1);
-    }
-
-    return b;
+    return Permute(BlockPermutation::ShiftCellsLeft());
   }
 
   template <typename T>
   void Basic_Block<T>::ShiftCellsRightInplace() {
-    Basic_Block<T> tmp = *this;
-
-    Get(0) = tmp.Get(15);
-
-    for (std::size_t i = 1; i < 16; i++) {
-      Get(i) = tmp.Get(i-1);
-    }
-
+    PermuteInplace(BlockPermutation::ShiftCellsRight());
     return;
   }
 
   template <typename T>
   Basic_Block<T> Basic_Block<T>::ShiftCellsRight() const {
-    Basic_Block<T> b;
-
-    b.Get(0) = Get(15);
-
-    for (std::size_t i = 1; i < 16; i++) {
-      b.Get(i) = Get(i-1);
-    }
-
-    return b;
+    return Permute(BlockPermutation::ShiftCellsRight());
   }
 
   template <typename T>
@@ -634,63 +414,14 @@ namespace Leonetienne::GCrypt {
   Basic_Block<T> Basic_Block<T>::ShiftBitsLeft() const {
     Basic_Block<T> b;
 
-    // First, copy this block over
-    b = *this;
-
-    // Then, shift all integers individually
-    for (std::size_t i = 0; i < data.size(); i++) {
-      b.data[i] <<= 1;
-    }
-
-    // Current state: the LSB is zero everywhere. We have to carry
-    // it over manually from the previous state.
-
-    // Carry over the MSB of data[i] to LSB of data[i-1]
-    constexpr std::size_t bitmaskMsb = 1 << (CHUNK_SIZE_BITS - 1);
-    constexpr std::size_t bitmaskLsb = 1;
-    for (int i = 0; i < data.size(); i++) {
-      const bool msb = data[i] & bitmaskMsb;
-
-      // Set the lsb
-      if (msb) {
-        b.data[Mod(i-1, data.size())] |= bitmaskLsb;
-      }
-      // Clear the lsb
-      else {
-        b.data[Mod(i-1, data.size())] &= ~bitmaskLsb;
-      }
-    }
+    Kernels::RotateBitsLeft(b.data.data(), data.data());
 
     return b;
   }
 
   template <typename T>
   void Basic_Block<T>::ShiftBitsLeftInplace() {
-    Basic_Block<T> tmp = *this;
-
-    // Then, shift all integers individually
-    for (std::size_t i = 0; i < data.size(); i++) {
-      data[i] <<= 1;
-    }
-
-    // Current state: the LSB is zero everywhere. We have to carry
-    // it over manually from the previous state.
-
-    // Carry over the MSB of data[i] to LSB of data[i-1]
-    constexpr std::size_t bitmaskMsb = 1 << (CHUNK_SIZE_BITS - 1);
-    constexpr std::size_t bitmaskLsb = 1;
-    for (int i = 0; i < data.size(); i++) {
-      const bool msb = tmp.data[i] & bitmaskMsb;
-
-      // Set the lsb
-      if (msb) {
-        data[Mod(i-1, data.size())] |= bitmaskLsb;
-      }
-      // Clear the lsb
-      else {
-        data[Mod(i-1, data.size())] &= ~bitmaskLsb;
-      }
-    }
+    Kernels::RotateBitsLeft(data.data(), data.data());
 
     return;
   }
@@ -699,63 +430,14 @@ namespace Leonetienne::GCrypt {
   Basic_Block<T> Basic_Block<T>::ShiftBitsRight() const {
     Basic_Block<T> b;
 
-    // First, copy this block over
-    b = *this;
-
-    // Then, shift all integers individually
-    for (std::size_t i = 0; i < data.size(); i++) {
-      b.data[i] >>= 1;
-    }
-
-    // Current state: the LSB is zero everywhere. We have to carry
-    // it over manually from the previous state.
-
-    // Carry over the LSB of data[i] to MSB of data[i+1]
-    constexpr std::size_t bitmaskMsb = 1 << (CHUNK_SIZE_BITS - 1);
-    constexpr std::size_t bitmaskLsb = 1;
-    for (int i = 0; i < data.size(); i++) {
-      const bool lsb = data[i] & bitmaskLsb;
-
-      // Set the msb
-      if (lsb) {
-        b.data[Mod(i+1, data.size())] |= bitmaskMsb;
-      }
-      // Clear the msb
-      else {
-        b.data[Mod(i+1, data.size())] &= ~bitmaskMsb;
-      }
-    }
+    Kernels::RotateBitsRight(b.data.data(), data.data());
 
     return b;
   }
 
   template <typename T>
   void Basic_Block<T>::ShiftBitsRightInplace() {
-    Basic_Block<T> tmp = *this;
-
-    // Then, shift all integers individually
-    for (std::size_t i = 0; i < data.size(); i++) {
-      data[i] >>= 1;
-    }
-
-    // Current state: the LSB is zero everywhere. We have to carry
-    // it over manually from the previous state.
-
-    // Carry over the LSB of data[i] to MSB of data[i+1]
-    constexpr std::size_t bitmaskMsb = 1 << (CHUNK_SIZE_BITS - 1);
-    constexpr std::size_t bitmaskLsb = 1;
-    for (int i = 0; i < data.size(); i++) {
-      const bool lsb = tmp.data[i] & bitmaskLsb;
-
-      // Set the msb
-      if (lsb) {
-        data[Mod(i+1, data.size())] |= bitmaskMsb;
-      }
-      // Clear the msb
-      else {
-        data[Mod(i+1, data.size())] &= ~bitmaskMsb;
-      }
-    }
+    Kernels::RotateBitsRight(data.data(), data.data());
 
     return;
   }
@@ -0,0 +1,143 @@
+#include "GCrypt/CheckpointIndex.h"
+#include "GCrypt/Feistel.h"
+#include "GCrypt/InitializationVector.h"
+#include "GCrypt/Util.h"
+#include <stdexcept>
+
+namespace {
+  // Identifies index files: "GCIX"
+  constexpr std::uint32_t INDEX_MAGIC = 0x58494347;
+  constexpr std::uint32_t INDEX_VERSION = 1;
+}
+
+namespace Leonetienne::GCrypt {
+
+  CheckpointIndex::CheckpointIndex() {
+  }
+
+  CheckpointIndex CheckpointIndex::Build(const Key& key, const std::size_t nBlocks, const std::size_t interval) {
+    if (interval == 0) {
+      throw std::invalid_argument("Attempted to build a checkpoint index with an interval of 0 blocks!");
+    }
+
+    CheckpointIndex index;
+    index.interval = interval;
+    index.nBlocks = nBlocks;
+
+    Keyset keyset;
+    Feistel::GenerateKeyset(keyset, key);
+
+    for (std::size_t block = 1; block < nBlocks; block++) {
+      if (block % interval == 0) {
+        index.checkpoints.emplace_back(SaveCheckpoint(keyset, key));
+      }
+
+      Feistel::RollKeyset(keyset);
+    }
+
+    keyset.Reset();
+
+    return index;
+  }
+
+  Keyset CheckpointIndex::KeysetAt(const std::size_t blockIndex, const Key& key) const {
+    Keyset keyset;
+    std::size_t block = 0;
+
+    // Start at the nearest checkpoint, if there is one
+    const std::size_t checkpoint = std::min(blockIndex / interval, checkpoints.size());
+    if (checkpoint > 0) {
+      keyset = RestoreCheckpoint(checkpoints[checkpoint - 1], key);
+      block = checkpoint * interval;
+    }
+    else {
+      Feistel::GenerateKeyset(keyset, key);
+    }
+
+    for (; block < blockIndex; block++) {
+      Feistel::RollKeyset(keyset);
+    }
+
+    return keyset;
+  }
+
+  Block CheckpointIndex::SaveCheckpoint(const Keyset& previous, const Key& key) {
+    // Rolling into the keyset of a block only reads the last round key of the block before.
+    // That is all a checkpoint has to remember.
+    // It gets enciphered as the first block a GCipher under the key would be. No keyset gets rolled for a next one.
+    Keyset keyset;
+    Feistel::GenerateKeyset(keyset, key);
+    const Block checkpoint = Feistel::Encipher(previous.roundKeys.back() ^ InitializationVector(key), keyset);
+
+    keyset.Reset();
+
+    return checkpoint;
+  }
+
+  Keyset CheckpointIndex::RestoreCheckpoint(const Block& checkpoint, const Key& key) {
+    Keyset keyset;
+    Feistel::GenerateKeyset(keyset, key);
+    const Block lastRoundKey = Feistel::Decipher(checkpoint, keyset) ^ InitializationVector(key);
+
+    keyset.Reset();
+    keyset.roundKeys.back() = lastRoundKey;
+    Feistel::RollKeyset(keyset);
+
+    return keyset;
+  }
+
+  std::size_t CheckpointIndex::GetInterval() const {
+    return interval;
+  }
+
+  std::size_t CheckpointIndex::GetBlockCount() const {
+    return nBlocks;
+  }
+
+  void CheckpointIndex::WriteToFile(const std::string& path) const {
+    // The first block is a header, all following blocks are checkpoints
+    Block header;
+    header.Reset();
+    header[0] = INDEX_MAGIC;
+    header[1] = INDEX_VERSION;
+    header[2] = (std::uint32_t)(interval & 0xFFFFFFFF);
+    header[3] = (std::uint32_t)((std::uint64_t)interval >> 32);
+    header[4] = (std::uint32_t)(nBlocks & 0xFFFFFFFF);
+    header[5] = (std::uint32_t)((std::uint64_t)nBlocks >> 32);
+
+    std::vector<Block> blocks;
+    blocks.reserve(checkpoints.size() + 1);
+    blocks.emplace_back(header);
+    blocks.insert(blocks.end(), checkpoints.begin(), checkpoints.end());
+
+    WriteBlocksToFile(path, blocks);
+
+    return;
+  }
+
+  CheckpointIndex CheckpointIndex::LoadFromFile(const std::string& path) {
+    const std::vector<Block> blocks = ReadFileToBlocks(path);
+
+    if ((blocks.empty()) || (blocks[0][0] != INDEX_MAGIC) || (blocks[0][1] != INDEX_VERSION)) {
+      throw std::runtime_error("Attempted to load a file that is not a checkpoint index!");
+    }
+
+    const Block& header = blocks[0];
+
+    CheckpointIndex index;
+    index.interval = (std::size_t)(header[2] | ((std::uint64_t)header[3] << 32));
+    index.nBlocks = (std::size_t)(header[4] | ((std::uint64_t)header[5] << 32));
+    index.checkpoints.assign(blocks.begin() + 1, blocks.end());
+
+    if (index.interval == 0) {
+      throw std::runtime_error("Attempted to load a corrupt checkpoint index!");
+    }
+
+    return index;
+  }
+
+  std::string CheckpointIndex::SidecarPath(const std::string& ciphertextPath) {
+    return ciphertextPath + ".gcidx";
+  }
+
+}
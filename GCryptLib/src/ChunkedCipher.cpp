@@ -0,0 +1,496 @@
+#include "GCrypt/ChunkedCipher.h"
+#include "GCrypt/GCipher.h"
+#include "GCrypt/BasicGCipher.h"
+#include "GCrypt/Feistel.h"
+#include "GCrypt/GHash.h"
+#include "GCrypt/InitializationVector.h"
+#include "GCrypt/ThreadJoiner.h"
+#include "GCrypt/Util.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+  using namespace Leonetienne::GCrypt;
+
+  // Identifies containers: "GCCK"
+  constexpr std::uint32_t CONTAINER_MAGIC = 0x4B434347;
+  constexpr std::uint32_t CONTAINER_VERSION = 1;
+
+  // Identifies fingerprint files: "GCFP"
+  constexpr std::uint32_t FINGERPRINT_MAGIC = 0x50464347;
+  constexpr std::uint32_t FINGERPRINT_VERSION = 1;
+
+  // Separates chunk key derivation from any other use of the master key
+  constexpr std::uint32_t CHUNK_KEY_DOMAIN = 0x79656B63;
+
+  // Separates fingerprints from any other use of a chunk key
+  constexpr std::uint32_t FINGERPRINT_DOMAIN = 0x72706E66;
+
+  // Splits a size_t over two block cells
+  void WriteSize(Block& block, const std::size_t index, const std::size_t value) {
+    block[index] = (std::uint32_t)(value & 0xFFFFFFFF);
+    block[index + 1] = (std::uint32_t)((std::uint64_t)value >> 32);
+    return;
+  }
+
+  std::size_t ReadSize(const Block& block, const std::size_t index) {
+    return (std::size_t)(block[index] | ((std::uint64_t)block[index + 1] << 32));
+  }
+
+  std::size_t BlocksFor(const std::size_t nBytes) {
+    return (nBytes + Block::BLOCK_SIZE - 1) / Block::BLOCK_SIZE;
+  }
+
+  // Where everything lives in a container
+  struct Layout {
+    std::size_t chunkSize = 0;
+    std::size_t cleartextLength = 0;
+    std::size_t nChunks = 0;
+
+    Layout(const std::size_t chunkSize, const std::size_t cleartextLength) :
+      chunkSize { chunkSize },
+      cleartextLength { cleartextLength },
+      nChunks { (cleartextLength + chunkSize - 1) / chunkSize }
+    {
+    }
+
+    std::size_t ChunkStart(const std::size_t i) const {
+      return i * chunkSize;
+    }
+
+    std::size_t ChunkLength(const std::size_t i) const {
+      return std::min(chunkSize, cleartextLength - ChunkStart(i));
+    }
+
+    // Header, and chunk table
+    std::size_t PayloadOffset() const {
+      return (1 + nChunks) * Block::BLOCK_SIZE;
+    }
+
+    std::size_t ContainerSize() const {
+      return PayloadOffset() + BlocksFor(cleartextLength) * Block::BLOCK_SIZE;
+    }
+
+    // Header: magic, version, chunk size, cleartext length, number of chunks
+    Block Header(const std::uint32_t magic, const std::uint32_t version) const {
+      Block header;
+      header.Reset();
+      header[0] = magic;
+      header[1] = version;
+      WriteSize(header, 2, chunkSize);
+      WriteSize(header, 4, cleartextLength);
+      WriteSize(header, 6, nChunks);
+
+      return header;
+    }
+
+    // Chunk table entry: offset and length, in blocks
+    Block TableEntry(const std::size_t i) const {
+      Block entry;
+      entry.Reset();
+      WriteSize(entry, 0, i * (chunkSize / Block::BLOCK_SIZE));
+      WriteSize(entry, 2, BlocksFor(ChunkLength(i)));
+
+      return entry;
+    }
+
+    // Will read a header, and make sure it describes a consistent layout
+    static Layout FromHeader(const Block& header, const std::uint32_t magic, const std::uint32_t version) {
+      if ((header[0] != magic) || (header[1] != version)) {
+        throw std::runtime_error("Leonetienne::GCrypt::ChunkedCipher received data that is not a chunked container.");
+      }
+
+      const std::size_t chunkSize = ReadSize(header, 2);
+      if ((chunkSize == 0) || (chunkSize % Block::BLOCK_SIZE != 0)) {
+        throw std::runtime_error("Leonetienne::GCrypt::ChunkedCipher received a malformed container.");
+      }
+
+      // Sizes this large would wrap around while computing the layout, to small values that look consistent
+      const std::size_t cleartextLength = ReadSize(header, 4);
+      if (cleartextLength > std::numeric_limits<std::size_t>::max() - (chunkSize - 1)) {
+        throw std::runtime_error("Leonetienne::GCrypt::ChunkedCipher received a malformed container.");
+      }
+
+      const Layout layout(chunkSize, cleartextLength);
+      if (layout.nChunks != ReadSize(header, 6)) {
+        throw std::runtime_error("Leonetienne::GCrypt::ChunkedCipher received a malformed container.");
+      }
+
+      // The header, the chunk table, and the payload have to fit into a size_t together
+      const std::size_t payloadSize = BlocksFor(cleartextLength) * Block::BLOCK_SIZE;
+      if (layout.nChunks >= (std::numeric_limits<std::size_t>::max() - payloadSize) / Block::BLOCK_SIZE) {
+        throw std::runtime_error("Leonetienne::GCrypt::ChunkedCipher received a malformed container.");
+      }
+
+      return layout;
+    }
+  };
+
+  // Calls job(i) for all i in [0, n), spread over up to nThreads threads (including this one).
+  // If a job throws, no more jobs get started, and the first exception gets rethrown on this thread, once all threads are joined.
+  template <typename Job>
+  void ForEachParallel(const std::size_t n, std::size_t nThreads, Job job) {
+    if (nThreads == 0) {
+      nThreads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+    }
+    nThreads = std::max<std::size_t>(std::min(nThreads, n), 1);
+
+    std::atomic<std::size_t> next { 0 };
+    std::mutex failureMutex;
+    std::exception_ptr failure;
+
+    const auto worker = [&next, n, &job, &failureMutex, &failure]() {
+      try {
+        for (std::size_t i = next++; i < n; i = next++) {
+          job(i);
+        }
+      }
+      catch (...) {
+        next = n;
+
+        std::lock_guard<std::mutex> lock(failureMutex);
+        if (!failure) {
+          failure = std::current_exception();
+        }
+      }
+    };
+
+    {
+      ThreadJoiner threads;
+      for (std::size_t i = 1; i < nThreads; i++) {
+        threads.Spawn(worker);
+      }
+      worker();
+    }
+
+    if (failure) {
+      std::rethrow_exception(failure);
+    }
+
+    return;
+  }
+
+  // Enciphers one chunk of cleartext into out, which has room for all its blocks
+  void EncipherChunk(const char* cleartext, const std::size_t length, const Key& key, const std::size_t chunkIndex, char* out) {
+    Key chunkKey = ChunkedCipher::DeriveChunkKey(key, chunkIndex);
+    BasicGCipher<CipherModes::CBC, CIPHER_DIRECTION::ENCIPHER> cipher(chunkKey);
+    chunkKey.Reset();
+
+    for (std::size_t offset = 0; offset < length; offset += Block::BLOCK_SIZE) {
+      Block block;
+      block.Reset();
+      memcpy(block.Data(), cleartext + offset, std::min<std::size_t>(Block::BLOCK_SIZE, length - offset));
+
+      const Block ciphertext = cipher.Digest(block);
+      memcpy(out + offset, ciphertext.Data(), Block::BLOCK_SIZE);
+    }
+
+    return;
+  }
+
+  // Hashes one chunk of cleartext, keyed with its chunk key.
+  // Without the key, a fingerprint tells nothing about the chunk.
+  Block FingerprintChunk(const char* cleartext, const std::size_t length, const Key& key, const std::size_t chunkIndex) {
+    Block keyBlock = ChunkedCipher::DeriveChunkKey(key, chunkIndex);
+    keyBlock[0] ^= FINGERPRINT_DOMAIN;
+
+    GHash hasher;
+    hasher.Digest(keyBlock);
+    keyBlock.Reset();
+
+    for (std::size_t offset = 0; offset < length; offset += Block::BLOCK_SIZE) {
+      Block block;
+      block.Reset();
+      memcpy(block.Data(), cleartext + offset, std::min<std::size_t>(Block::BLOCK_SIZE, length - offset));
+
+      hasher.Digest(block);
+    }
+
+    hasher.Digest(GHash::LengthBlock(length));
+
+    return hasher.GetHashsum();
+  }
+
+  std::string ReadWholeFile(const std::string& filename) {
+    std::ifstream ifs(filename, std::ios::binary);
+    if (!ifs.good()) {
+      throw std::runtime_error("Unable to open ifilestream!");
+    }
+
+    std::stringstream ss;
+    ss << ifs.rdbuf();
+
+    return ss.str();
+  }
+}
+
+namespace Leonetienne::GCrypt {
+
+  Key ChunkedCipher::DeriveChunkKey(const Key& key, const std::size_t chunkIndex) {
+    // The chunk key is the encipherment of the chunk index, under the master key
+    Block tag;
+    tag.Reset();
+    tag[0] = CHUNK_KEY_DOMAIN;
+    WriteSize(tag, 1, chunkIndex);
+
+    // This is the first block a GCipher under the master key would yield.
+    // It is the only block, so no keyset gets rolled for a next one.
+    Keyset keyset;
+    Feistel::GenerateKeyset(keyset, key);
+    const Key chunkKey(Feistel::Encipher(tag ^ InitializationVector(key), keyset));
+
+    keyset.Reset();
+
+    return chunkKey;
+  }
+
+  std::string ChunkedCipher::Encrypt(const std::string& cleartext, const Key& key, const std::size_t chunkSize, const std::size_t nThreads) {
+    if ((chunkSize == 0) || (chunkSize % Block::BLOCK_SIZE != 0)) {
+      throw std::invalid_argument("Leonetienne::GCrypt::ChunkedCipher::Encrypt() received a chunk size not a multiple of block size.");
+    }
+
+    const Layout layout(chunkSize, cleartext.length());
+    std::string container(layout.ContainerSize(), '\0');
+
+    // Header, and chunk table
+    const Block header = layout.Header(CONTAINER_MAGIC, CONTAINER_VERSION);
+    memcpy(container.data(), header.Data(), Block::BLOCK_SIZE);
+
+    for (std::size_t i = 0; i < layout.nChunks; i++) {
+      const Block entry = layout.TableEntry(i);
+      memcpy(container.data() + (1 + i) * Block::BLOCK_SIZE, entry.Data(), Block::BLOCK_SIZE);
+    }
+
+    // Encipher all chunks concurrently. Each one writes to its own place of the container.
+    ForEachParallel(layout.nChunks, nThreads, [&cleartext, &container, &key, &layout](const std::size_t i) {
+      EncipherChunk(
+        cleartext.data() + layout.ChunkStart(i),
+        layout.ChunkLength(i),
+        key,
+        i,
+        container.data() + layout.PayloadOffset() + layout.ChunkStart(i)
+      );
+    });
+
+    return container;
+  }
+
+  std::string ChunkedCipher::Decrypt(const std::string& container, const Key& key, const std::size_t nThreads) {
+    if (container.length() < Block::BLOCK_SIZE) {
+      throw std::runtime_error("Leonetienne::GCrypt::ChunkedCipher::Decrypt() received a container without header.");
+    }
+
+    Block header;
+    memcpy(header.Data(), container.data(), Block::BLOCK_SIZE);
+
+    const Layout layout = Layout::FromHeader(header, CONTAINER_MAGIC, CONTAINER_VERSION);
+
+    if (container.length() != layout.ContainerSize()) {
+      throw std::runtime_error("Leonetienne::GCrypt::ChunkedCipher::Decrypt() received a malformed container.");
+    }
+
+    // Read the chunk table, and make sure each chunk lies where it has to
+    for (std::size_t i = 0; i < layout.nChunks; i++) {
+      Block entry;
+      memcpy(entry.Data(), container.data() + (1 + i) * Block::BLOCK_SIZE, Block::BLOCK_SIZE);
+
+      if (entry != layout.TableEntry(i)) {
+        throw std::runtime_error("Leonetienne::GCrypt::ChunkedCipher::Decrypt() received a malformed chunk table.");
+      }
+    }
+
+    std::string cleartext(layout.cleartextLength, '\0');
+
+    // Decipher all chunks concurrently. Each one writes to its own place of the cleartext.
+    ForEachParallel(layout.nChunks, nThreads, [&cleartext, &container, &key, &layout](const std::size_t i) {
+      const std::size_t chunkStart = layout.ChunkStart(i);
+      const std::size_t chunkLength = layout.ChunkLength(i);
+
+      Key chunkKey = DeriveChunkKey(key, i);
+      BasicGCipher<CipherModes::CBC, CIPHER_DIRECTION::DECIPHER> cipher(chunkKey);
+      chunkKey.Reset();
+
+      for (std::size_t offset = 0; offset < chunkLength; offset += Block::BLOCK_SIZE) {
+        Block block;
+        memcpy(block.Data(), container.data() + layout.PayloadOffset() + chunkStart + offset, Block::BLOCK_SIZE);
+
+        const Block decipheredBlock = cipher.Digest(block);
+        memcpy(cleartext.data() + chunkStart + offset, decipheredBlock.Data(), std::min<std::size_t>(Block::BLOCK_SIZE, chunkLength - offset));
+      }
+    });
+
+    return cleartext;
+  }
+
+  bool ChunkedCipher::EncryptFile(const std::string& filename_in, const std::string& filename_out, const Key& key, const std::size_t chunkSize, const std::size_t nThreads) {
+    try {
+      const std::string container = Encrypt(ReadWholeFile(filename_in), key, chunkSize, nThreads);
+
+      std::ofstream ofs(filename_out, std::ios::binary);
+      if (!ofs.good()) {
+        return false;
+      }
+      ofs.write(container.data(), container.length());
+
+      return ofs.good();
+    }
+    catch (std::exception&) {
+      return false;
+    }
+  }
+
+  bool ChunkedCipher::DecryptFile(const std::string& filename_in, const std::string& filename_out, const Key& key, const std::size_t nThreads) {
+    try {
+      const std::string cleartext = Decrypt(ReadWholeFile(filename_in), key, nThreads);
+
+      std::ofstream ofs(filename_out, std::ios::binary);
+      if (!ofs.good()) {
+        return false;
+      }
+      ofs.write(cleartext.data(), cleartext.length());
+
+      return ofs.good();
+    }
+    catch (std::exception&) {
+      return false;
+    }
+  }
+
+  bool ChunkedCipher::UpdateFile(const std::string& filename_in, const std::string& filename_container, const Key& key, const std::size_t chunkSize, const std::size_t nThreads, std::size_t* nChunksRewritten) {
+    try {
+      const std::string cleartext = ReadWholeFile(filename_in);
+
+      // Pick up the existing container and its fingerprints, if they belong together
+      std::vector<Block> previousFingerprints;
+      std::size_t previousChunkSize = 0;
+      std::size_t previousContainerSize = 0;
+      try {
+        std::ifstream ifs(filename_container, std::ios::binary | std::ios::ate);
+        const std::size_t containerSize = ifs.good() ? (std::size_t)ifs.tellg() : 0;
+
+        Block header;
+        header.Reset();
+        ifs.seekg(0);
+        ifs.read((char*)(void*)header.Data(), Block::BLOCK_SIZE);
+
+        const Layout previous = Layout::FromHeader(header, CONTAINER_MAGIC, CONTAINER_VERSION);
+        const std::vector<Block> fingerprints = ReadFileToBlocks(FingerprintPath(filename_container));
+
+        if (
+          (containerSize == previous.ContainerSize()) &&
+          (fingerprints.size() == 1 + previous.nChunks) &&
+          (fingerprints[0] == previous.Header(FINGERPRINT_MAGIC, FINGERPRINT_VERSION))
+        ) {
+          previousFingerprints.assign(fingerprints.begin() + 1, fingerprints.end());
+          previousChunkSize = previous.chunkSize;
+          previousContainerSize = containerSize;
+        }
+      }
+      catch (std::runtime_error&) {
+        // Nothing to update. Encipher everything.
+      }
+
+      // An existing container keeps its chunk size
+      const Layout layout(previousChunkSize ? previousChunkSize : chunkSize, cleartext.length());
+      if ((layout.chunkSize == 0) || (layout.chunkSize % Block::BLOCK_SIZE != 0)) {
+        return false;
+      }
+
+      // Fingerprint the new cleartext
+      std::vector<Block> fingerprints(layout.nChunks);
+      ForEachParallel(layout.nChunks, nThreads, [&cleartext, &key, &layout, &fingerprints](const std::size_t i) {
+        fingerprints[i] = FingerprintChunk(cleartext.data() + layout.ChunkStart(i), layout.ChunkLength(i), key, i);
+      });
+
+      // The chunk table moves the payload, if the number of chunks changes. Then, every chunk gets rewritten.
+      const bool inPlace = (!previousFingerprints.empty()) && (previousFingerprints.size() == layout.nChunks);
+
+      std::vector<std::size_t> changedChunks;
+      for (std::size_t i = 0; i < layout.nChunks; i++) {
+        if ((!inPlace) || (fingerprints[i] != previousFingerprints[i])) {
+          changedChunks.emplace_back(i);
+        }
+      }
+
+      // Encipher the changed chunks concurrently
+      std::vector<std::string> enciphered(changedChunks.size());
+      ForEachParallel(changedChunks.size(), nThreads, [&cleartext, &key, &layout, &changedChunks, &enciphered](const std::size_t j) {
+        const std::size_t i = changedChunks[j];
+
+        enciphered[j].assign(BlocksFor(layout.ChunkLength(i)) * Block::BLOCK_SIZE, '\0');
+        EncipherChunk(cleartext.data() + layout.ChunkStart(i), layout.ChunkLength(i), key, i, enciphered[j].data());
+      });
+
+      // Drop the fingerprints before touching the container.
+      // Should writing it fail halfway, they would claim chunks to be up to date that never got written.
+      std::error_code removeError;
+      std::filesystem::remove(FingerprintPath(filename_container), removeError);
+      if (removeError) {
+        return false;
+      }
+
+      // Write the header, the chunk table, and the changed chunks. Leave everything else be.
+      if (!inPlace) {
+        std::ofstream truncate(filename_container, std::ios::binary | std::ios::trunc);
+      }
+
+      {
+        std::fstream fs(filename_container, std::ios::binary | std::ios::in | std::ios::out);
+        if (!fs.good()) {
+          return false;
+        }
+
+        const Block header = layout.Header(CONTAINER_MAGIC, CONTAINER_VERSION);
+        fs.write((const char*)(const void*)header.Data(), Block::BLOCK_SIZE);
+
+        for (std::size_t i = 0; i < layout.nChunks; i++) {
+          const Block entry = layout.TableEntry(i);
+          fs.write((const char*)(const void*)entry.Data(), Block::BLOCK_SIZE);
+        }
+
+        for (std::size_t j = 0; j < changedChunks.size(); j++) {
+          fs.seekp(layout.PayloadOffset() + layout.ChunkStart(changedChunks[j]));
+          fs.write(enciphered[j].data(), enciphered[j].length());
+        }
+
+        fs.flush();
+        if (!fs.good()) {
+          return false;
+        }
+      }
+
+      // The last chunk may have shrunk
+      if ((inPlace) && (layout.ContainerSize() < previousContainerSize)) {
+        std::filesystem::resize_file(filename_container, layout.ContainerSize());
+      }
+
+      // Remember the fingerprints, for the next update. Only now the container matches them.
+      fingerprints.insert(fingerprints.begin(), layout.Header(FINGERPRINT_MAGIC, FINGERPRINT_VERSION));
+      WriteBlocksToFile(FingerprintPath(filename_container), fingerprints);
+
+      if (nChunksRewritten) {
+        *nChunksRewritten = changedChunks.size();
+      }
+
+      return true;
+    }
+    catch (std::exception&) {
+      return false;
+    }
+  }
+
+  std::string ChunkedCipher::FingerprintPath(const std::string& containerPath) {
+    return containerPath + ".gcfp";
+  }
+
+}
@@ -2,122 +2,385 @@
 #include "GCrypt/Feistel.h"
 #include "GCrypt/Util.h"
 #include "GCrypt/Config.h"
-#include "GCrypt/SBoxLookup.h"
+#include "GCrypt/FeistelKernels.h"
+
+namespace {
+  using Leonetienne::GCrypt::BlockPermutation;
+
+  // Consecutive cell permutations, composed into one each
+  constexpr BlockPermutation ROUND_JUMBLE_PERMUTATION =
+    BlockPermutation::ShiftRowsUp().Then(BlockPermutation::ShiftCellsRight());
+
+  constexpr BlockPermutation ROUND_UNJUMBLE_PERMUTATION =
+    BlockPermutation::ShiftCellsLeft().Then(BlockPermutation::ShiftRowsDown());
+
+  constexpr BlockPermutation SHIFT_COLUMNS_LEFT_PERMUTATION = BlockPermutation::ShiftColumnsLeft();
+  constexpr BlockPermutation SHIFT_COLUMNS_RIGHT_PERMUTATION = BlockPermutation::ShiftColumnsRight();
+}
 
 namespace Leonetienne::GCrypt {
 
-  Feistel::Feistel() {
+  template <std::size_t Rounds>
+  BasicFeistel<Rounds>::BasicFeistel() {
   }
 
-  Feistel::Feistel(const Key& key) {
+  template <std::size_t Rounds>
+  BasicFeistel<Rounds>::BasicFeistel(const Key& key) {
     SetKey(key);
   }
 
-  Feistel::~Feistel() {
+  template <std::size_t Rounds>
+  BasicFeistel<Rounds>::~BasicFeistel() {
     ZeroKeyMemory();
   }
 
-  void Feistel::SetKey(const Key& key) {
+  template <std::size_t Rounds>
+  void BasicFeistel<Rounds>::SetKey(const Key& key) {
     GenerateRoundKeys(key);
     isInitialized = true;
   }
 
-  Block Feistel::Encipher(const Block& data) {
-    return Run(data, false);
+  template <std::size_t Rounds>
+  Block BasicFeistel<Rounds>::Encipher(const Block& data) {
+    return Run<false>(data);
+  }
+
+  template <std::size_t Rounds>
+  Block BasicFeistel<Rounds>::Decipher(const Block& data) {
+    return Run<true>(data);
+  }
+
+  template <std::size_t Rounds>
+  Block BasicFeistel<Rounds>::Encipher(const Block& data, const BasicKeyset<Rounds>& keyset) {
+    return Run<false>(data, keyset);
+  }
+
+  template <std::size_t Rounds>
+  Block BasicFeistel<Rounds>::EncipherAndGenerateKeyset(const Block& data, const BasicKeyset<Rounds>& keyset, BasicKeyset<Rounds>& nextKeyset, const Key& nextSeedKey) {
+    nextKeyset.Reset();
+    nextKeyset = BasicKeyset<Rounds>();
+    nextKeyset.roundKeys[0] = nextSeedKey;
+
+    // Track where in the chain of round key derivations we are, so that it can be advanced one step at a time
+    std::size_t roundKeyIndex = 1;
+    std::size_t step = 0;
+
+    const auto generateStep = [&]() {
+      if (roundKeyIndex < Rounds) {
+        Kernels::DeriveRoundKeyStep(step, nextKeyset.roundKeys[roundKeyIndex].Data(), nextKeyset.roundKeys[roundKeyIndex - 1].Data());
+
+        if (++step == Kernels::KEY_DERIVATION_STEPS) {
+          step = 0;
+          roundKeyIndex++;
+        }
+      }
+
+      return;
+    };
+
+    Block block = data;
+    const BasicKeyset<Rounds>* const keysetPtr = &keyset;
+    RunLanes<false, 1>(&block, &keysetPtr, generateStep);
+
+    // Whatever did not fit
+    while (roundKeyIndex < Rounds) {
+      generateStep();
+    }
+    DeriveReducedRoundKeys(nextKeyset);
+
+    return block;
   }
 
-  Block Feistel::Decipher(const Block& data) {
-    return Run(data, true);
+  template <std::size_t Rounds>
+  Block BasicFeistel<Rounds>::Decipher(const Block& data, const BasicKeyset<Rounds>& keyset) {
+    return Run<true>(data, keyset);
   }
 
-  Block Feistel::Run(const Block& data, bool modeEncrypt) {
+  template <std::size_t Rounds>
+  template <bool modeEncrypt>
+  Block BasicFeistel<Rounds>::Run(const Block& data) {
     if (!isInitialized) {
       throw std::runtime_error("Attempted to digest data on uninitialized GCipher!");
     }
 
+    // The next block needs a new set of round keys, derived from the last one.
+    // They get derived while this block runs through its rounds.
+    const Block result = RunAndRoll<modeEncrypt>(data, keyset, nextKeyset);
+
+    // Block has finished de*ciphering. Move on to the keyset of the next one.
+    std::swap(keyset, nextKeyset);
+
+    return result;
+  }
+
+  template <std::size_t Rounds>
+  template <bool modeEncrypt>
+  Block BasicFeistel<Rounds>::Run(const Block& data, const BasicKeyset<Rounds>& keyset) {
+    const auto splitData = FeistelSplit(data);
+    Halfblock l = splitData.first;
+    Halfblock r = splitData.second;
+
+    RunRounds<modeEncrypt, false>(l, r, keyset, nullptr, std::make_index_sequence<Rounds>());
+
+    return FeistelCombine(r, l);
+  }
+
+  template <std::size_t Rounds>
+  template <bool modeEncrypt>
+  Block BasicFeistel<Rounds>::RunAndRoll(const Block& data, const BasicKeyset<Rounds>& keyset, BasicKeyset<Rounds>& nextKeyset) {
     const auto splitData = FeistelSplit(data);
     Halfblock l = splitData.first;
     Halfblock r = splitData.second;
 
+    nextKeyset = keyset;
+    SeedRoll(nextKeyset);
+
+    // Each round derives one round key of the next keyset on the side
+    RunRounds<modeEncrypt, true>(l, r, keyset, &nextKeyset, std::make_index_sequence<Rounds>());
+
+    DeriveReducedRoundKeys(nextKeyset);
+
+    return FeistelCombine(r, l);
+  }
+
+  template <std::size_t Rounds>
+  template <bool modeEncrypt, bool rollKeys, std::size_t... roundIndices>
+  void BasicFeistel<Rounds>::RunRounds(Halfblock& l, Halfblock& r, const BasicKeyset<Rounds>& keyset, BasicKeyset<Rounds>* nextKeyset, std::index_sequence<roundIndices...>) {
+    // Expands to one Round() call per round index, in order
+    (Round<modeEncrypt, rollKeys, roundIndices>(l, r, keyset, nextKeyset), ...);
+
+    return;
+  }
+
+  template <std::size_t Rounds>
+  template <bool modeEncrypt, bool rollKeys, std::size_t roundIndex>
+  void BasicFeistel<Rounds>::Round(Halfblock& l, Halfblock& r, const BasicKeyset<Rounds>& keyset, BasicKeyset<Rounds>* nextKeyset) {
     Halfblock tmp;
 
-    for (std::size_t i = 0; i < N_ROUNDS; i++) {
+    // Encryption
+    if constexpr (modeEncrypt) {
+      const Key& roundKey = std::get<roundIndex>(keyset.roundKeys);
+      const Halfblock& reducedRoundKey = std::get<roundIndex>(keyset.reducedRoundKeys);
+
+      // Do a feistel round
+      tmp = r;
+      r = l ^ RoundFunction<rollKeys, roundIndex>(r, roundKey, nextKeyset);
+      l = tmp;
+
+      // Jumble it up a bit more
+      // (shift rows up, then shift cells right)
+      l.PermuteInplace(ROUND_JUMBLE_PERMUTATION);
+      l.ShiftBitsLeftInplace();
+      l.ShiftColumnsLeftInplace();
+      // Seal all these operations with a key
+      l += reducedRoundKey;
+    }
+
+    // Decryption
+    else {
+      // Decryption needs keys in reverse order
+      const Key& roundKey = std::get<Rounds - roundIndex - 1>(keyset.roundKeys);
+      const Halfblock& reducedRoundKey = std::get<Rounds - roundIndex - 1>(keyset.reducedRoundKeys);
+
+      // Unjumble the jumble
+      r -= reducedRoundKey;
+      r.ShiftColumnsRightInplace();
+      r.ShiftBitsRightInplace();
+      // (shift cells left, then shift rows down)
+      r.PermuteInplace(ROUND_UNJUMBLE_PERMUTATION);
+
+      // Do a feistel round
+      tmp = r;
+      r = l ^ RoundFunction<rollKeys, roundIndex>(r, roundKey, nextKeyset);
+      l = tmp;
+    }
+
+    return;
+  }
+
+  template <std::size_t Rounds>
+  template <std::size_t Lanes>
+  void BasicFeistel<Rounds>::EncipherLanes(Block* blocks, const BasicKeyset<Rounds>* const* keysets) {
+    RunLanes<false, Lanes>(blocks, keysets, []() {});
+    return;
+  }
+
+  template <std::size_t Rounds>
+  template <std::size_t Lanes>
+  void BasicFeistel<Rounds>::DecipherLanes(Block* blocks, const BasicKeyset<Rounds>* const* keysets) {
+    RunLanes<true, Lanes>(blocks, keysets, []() {});
+    return;
+  }
+
+  template <std::size_t Rounds>
+  template <std::size_t Lanes>
+  void BasicFeistel<Rounds>::DecipherLanesAndRoll(Block* blocks, const BasicKeyset<Rounds>* const* keysets, BasicKeyset<Rounds>* const* nextKeysets) {
+    // Rolling the next keysets is one chain of steps, each depending on the one before.
+    // Track where in that chain we are, so that it can be advanced a few steps at a time.
+    std::size_t keysetIndex = 0;
+    std::size_t roundKeyIndex = 0;
+    std::size_t step = 0;
+
+    const auto rollStep = [&]() {
+      if (keysetIndex == Lanes) {
+        return;
+      }
 
-      // Encryption
-      if (modeEncrypt) {
-        const std::size_t keyIndex = i;
+      BasicKeyset<Rounds>& keyset = *nextKeysets[keysetIndex];
 
-        // Do a feistel round
-        tmp = r;
-        r = l ^ F(r, roundKeys[keyIndex]);
-        l = tmp;
+      // Start the keyset off where the one before it ends, as RollKeyset() does
+      if (roundKeyIndex == 0) {
+        keyset = (keysetIndex == 0) ? *keysets[Lanes - 1] : *nextKeysets[keysetIndex - 1];
+        SeedRoll(keyset);
+        roundKeyIndex = 1;
+      }
 
-        // Jumble it up a bit more
-        l.ShiftRowsUpInplace();
-        l.ShiftCellsRightInplace();
-        l.ShiftBitsLeftInplace();
-        l.ShiftColumnsLeftInplace();
-        // Seal all these operations with a key
-        l += ReductionFunction(roundKeys[keyIndex]);
+      else if (roundKeyIndex < Rounds) {
+        Kernels::DeriveRoundKeyStep(step, keyset.roundKeys[roundKeyIndex].Data(), keyset.roundKeys[roundKeyIndex - 1].Data());
+
+        if (++step == Kernels::KEY_DERIVATION_STEPS) {
+          step = 0;
+          roundKeyIndex++;
+        }
       }
 
-      // Decryption
       else {
-        // Decryption needs keys in reverse order
-        const std::size_t keyIndex = N_ROUNDS - i - 1;
-
-        // Unjumble the jumble
-        r -= ReductionFunction(roundKeys[keyIndex]);
-        r.ShiftColumnsRightInplace();
-        r.ShiftBitsRightInplace();
-        r.ShiftCellsLeftInplace();
-        r.ShiftRowsDownInplace();
-
-        // Do a feistel round
-        tmp = r;
-        r = l ^ F(r, roundKeys[keyIndex]);
-        l = tmp;
+        DeriveReducedRoundKeys(keyset);
+        keysetIndex++;
+        roundKeyIndex = 0;
       }
 
+      return;
+    };
+
+    // There are about twice as many steps to the rolls as there are places in the rounds to put them
+    RunLanes<true, Lanes>(blocks, keysets, [&]() { rollStep(); rollStep(); });
+
+    // Whatever did not fit
+    while (keysetIndex < Lanes) {
+      rollStep();
     }
 
-    // Block has finished de*ciphering.
-    // Let's generate a new set of round keys.
-    GenerateRoundKeys(roundKeys.back());
+    return;
+  }
 
-    return FeistelCombine(r, l);
+  template <std::size_t Rounds>
+  template <bool modeEncrypt, std::size_t Lanes, typename SideWork>
+  void BasicFeistel<Rounds>::RunLanes(Block* blocks, const BasicKeyset<Rounds>* const* keysets, const SideWork& sideWork) {
+    Halfblock l[Lanes];
+    Halfblock r[Lanes];
+
+    for (std::size_t i = 0; i < Lanes; i++) {
+      memcpy(l[i].Data(), blocks[i].Data(), Halfblock::BLOCK_SIZE);
+      memcpy(r[i].Data(), blocks[i].Data() + 8, Halfblock::BLOCK_SIZE);
+    }
+
+    RunRoundsLanes<modeEncrypt, Lanes>(l, r, keysets, sideWork, std::make_index_sequence<Rounds>());
+
+    for (std::size_t i = 0; i < Lanes; i++) {
+      blocks[i] = FeistelCombine(r[i], l[i]);
+    }
+
+    return;
   }
 
-  Halfblock Feistel::F(Halfblock m, const Key& key) {
+  template <std::size_t Rounds>
+  template <bool modeEncrypt, std::size_t Lanes, typename SideWork, std::size_t... roundIndices>
+  void BasicFeistel<Rounds>::RunRoundsLanes(Halfblock* l, Halfblock* r, const BasicKeyset<Rounds>* const* keysets, const SideWork& sideWork, std::index_sequence<roundIndices...>) {
+    // Expands to one RoundLanes() call per round index, in order
+    (RoundLanes<modeEncrypt, roundIndices, Lanes>(l, r, keysets, sideWork), ...);
 
-    // Made-up F function:
-    // Expand to full bitwidth
-    Block m_expanded = ExpansionFunction(m);
+    return;
+  }
+
+  template <std::size_t Rounds>
+  template <bool modeEncrypt, std::size_t roundIndex, std::size_t Lanes, typename SideWork>
+  void BasicFeistel<Rounds>::RoundLanes(Halfblock* l, Halfblock* r, const BasicKeyset<Rounds>* const* keysets, const SideWork& sideWork) {
+    // Does exactly what Round() does, one step at a time for all lanes.
+    // sideWork() gets called in between the steps.
+    constexpr std::size_t keyIndex = modeEncrypt ? roundIndex : Rounds - roundIndex - 1;
+
+    // Decryption unjumbles before the feistel round
+    if constexpr (!modeEncrypt) {
+      for (std::size_t i = 0; i < Lanes; i++) {
+        std::uint16_t* const x = r[i].Data();
+        Kernels::Sub(x, x, std::get<keyIndex>(keysets[i]->reducedRoundKeys).Data());
+        Kernels::PermuteCells(x, x, SHIFT_COLUMNS_RIGHT_PERMUTATION.Data());
+        Kernels::RotateBitsRight(x, x);
+        Kernels::PermuteCells(x, x, ROUND_UNJUMBLE_PERMUTATION.Data());
+      }
+      sideWork();
+    }
+
+    // Do a feistel round on all lanes at once
+    Halfblock f[Lanes];
+    std::uint16_t* out[Lanes];
+    const std::uint16_t* m[Lanes];
+    const std::uint32_t* keys[Lanes];
+    for (std::size_t i = 0; i < Lanes; i++) {
+      out[i] = f[i].Data();
+      m[i] = r[i].Data();
+      keys[i] = std::get<keyIndex>(keysets[i]->roundKeys).Data();
+    }
+
+    Kernels::FLanes<Lanes>(out, m, keys, sideWork);
+
+    for (std::size_t i = 0; i < Lanes; i++) {
+      Kernels::Xor(f[i].Data(), f[i].Data(), l[i].Data());
+      l[i] = r[i];
+      r[i] = f[i];
+    }
 
-    // Mix up the block a bit
-    m_expanded.ShiftCellsRightInplace();
-    m_expanded.ShiftRowsUpInplace();
+    // Encryption jumbles after the feistel round
+    if constexpr (modeEncrypt) {
+      for (std::size_t i = 0; i < Lanes; i++) {
+        std::uint16_t* const x = l[i].Data();
+        Kernels::PermuteCells(x, x, ROUND_JUMBLE_PERMUTATION.Data());
+        Kernels::RotateBitsLeft(x, x);
+        Kernels::PermuteCells(x, x, SHIFT_COLUMNS_LEFT_PERMUTATION.Data());
+        Kernels::Add(x, x, std::get<keyIndex>(keysets[i]->reducedRoundKeys).Data());
+      }
+      sideWork();
+    }
 
-    // Matrix-mult with key (this is irreversible)
-    m_expanded *= key;
+    return;
+  }
 
-    // Now do a bitshift
-    m_expanded.ShiftBitsLeftInplace();
+  template <std::size_t Rounds>
+  template <bool rollKeys, std::size_t roundIndex>
+  Halfblock BasicFeistel<Rounds>::RoundFunction(const Halfblock& m, const Key& key, BasicKeyset<Rounds>* nextKeyset) {
+    // There is one round key less to derive than there are rounds. The first one is the seed.
+    if constexpr ((rollKeys) && (roundIndex + 1 < Rounds)) {
+      Halfblock hb;
+      Kernels::FAndDeriveRoundKey(
+        hb.Data(), m.Data(), key.Data(),
+        nextKeyset->roundKeys[roundIndex + 1].Data(), nextKeyset->roundKeys[roundIndex].Data()
+      );
+
+      return hb;
+    }
 
-    // Apply the sbox
-    SBox(m_expanded);
+    else {
+      return F(m, key);
+    }
+  }
 
-    // Reduce back to a halfblock
-    Halfblock hb = ReductionFunction(m_expanded);
+  template <std::size_t Rounds>
+  Halfblock BasicFeistel<Rounds>::F(Halfblock m, const Key& key) {
 
-    // To jumble it up a last time,
-    // matrix-multiply it with the input halfblock
-    hb *= m;
+    // Made-up F function:
+    // Expand to full bitwidth, mix it up a bit, matrix-mult with the key (this is irreversible),
+    // bitshift it, apply the sbox, and reduce it back to a halfblock.
+    // To jumble it up a last time, matrix-multiply it with the input halfblock.
+    // All of this happens in a single fused kernel, without block temporaries.
+    Halfblock hb;
+    Kernels::F(hb.Data(), m.Data(), key.Data());
 
     return hb;
   }
 
-  std::pair<Halfblock, Halfblock> Feistel::FeistelSplit(const Block& block) {
+  template <std::size_t Rounds>
+  std::pair<Halfblock, Halfblock> BasicFeistel<Rounds>::FeistelSplit(const Block& block) {
     Halfblock l;
     Halfblock r;
 
@@ -128,7 +391,8 @@ namespace Leonetienne::GCrypt {
     return std::make_pair(l, r);
   }
 
-  Block Feistel::FeistelCombine(const Halfblock& l, const Halfblock& r) {
+  template <std::size_t Rounds>
+  Block BasicFeistel<Rounds>::FeistelCombine(const Halfblock& l, const Halfblock& r) {
     Block b;
 
     memcpy(b.Data(), l.Data(), Halfblock::BLOCK_SIZE);
@@ -138,47 +402,34 @@ namespace Leonetienne::GCrypt {
     return b;
   }
 
-  Block Feistel::ExpansionFunction(const Halfblock& hb) {
+  template <std::size_t Rounds>
+  Block BasicFeistel<Rounds>::ExpansionFunction(const Halfblock& hb) {
     Block b;
 
-    // Copy the bits over
-    for (std::size_t i = 0; i < 16; i++) {
-      b[i] = hb[i];
-    }
-
-    // Multiply the block a few tims with a bitshifted version
+    // Copy the bits over, and multiply the block
+    // a few times with a bitshifted version.
     // This is irriversible, too
-    for (std::size_t i = 0; i < 3; i++) {
-      b *= b.ShiftBitsRight();
-    }
+    Kernels::Expand(b.Data(), hb.Data());
 
     return b;
   }
 
-  Halfblock Feistel::ReductionFunction(const Block& block) {
+  template <std::size_t Rounds>
+  Halfblock BasicFeistel<Rounds>::ReductionFunction(const Block& block) {
 
     // Just apply a modulo operation, remapping a 32bit integer
     // onto 16bit space (default configuration).
     // Without saying, modulo is irreversible.
     Halfblock hb;
-    for (std::size_t i = 0; i < 16; i++) {
-      hb[i] = block[i] % (1 << (Halfblock::CHUNK_SIZE_BITS - 1));
-    }
+    Kernels::Reduce(hb.Data(), block.Data());
 
     return hb;
   }
 
-  void Feistel::SBox(Block& block) {
-
-    std::uint8_t* curByte = (std::uint8_t*)(void*)block.Data();
-
-    // Iterate over all bytes in the block
-    for (std::size_t i = 0; i < Block::BLOCK_SIZE; i++) {
-      curByte++;
-
-      // Subsitute byte
-      *curByte = sboxLookup[*curByte];
-    }
+  template <std::size_t Rounds>
+  void BasicFeistel<Rounds>::SBox(Block& block) {
+    // Subsitute all bytes (but the first one)
+    Kernels::SBox((std::uint8_t*)(void*)block.Data());
 
     return;
   }
@@ -211,44 +462,120 @@ namespace Leonetienne::GCrypt {
   }
   */
 
-  void Feistel::GenerateRoundKeys(const Key& seedKey) {
+  template <std::size_t Rounds>
+  void BasicFeistel<Rounds>::GenerateRoundKeys(const Key& seedKey) {
+    GenerateKeyset(keyset, seedKey);
+
+    return;
+  }
+
+  template <std::size_t Rounds>
+  void BasicFeistel<Rounds>::GenerateKeyset(BasicKeyset<Rounds>& keyset, const Key& seedKey) {
     // Clear initial key memory
-    ZeroKeyMemory();
-    roundKeys = Keyset();
+    keyset.Reset();
+    keyset = BasicKeyset<Rounds>();
+    std::array<Key, Rounds>& roundKeys = keyset.roundKeys;
 
     // Derive all round keys with simple matrix operations
     roundKeys[0] = seedKey;
 
     for (std::size_t i = 1; i < roundKeys.size(); i++) {
-      // Initialize new round key with last round key
-      const Key& lastKey = roundKeys[i - 1];
-      roundKeys[i] = lastKey;
-
-      // Stir it good
-      roundKeys[i].ShiftRowsUpInplace();
-
-      // Bitshift and matrix-mult 3 times
-      // (each time jumbles it up pretty good)
-      // This is irreversible
-      roundKeys[i].ShiftBitsRightInplace();
-      roundKeys[i] *= lastKey;
-      roundKeys[i].ShiftBitsRightInplace();
-      roundKeys[i] *= lastKey;
-      roundKeys[i].ShiftBitsRightInplace();
-      roundKeys[i] *= lastKey;
-
-      // Lastly, do apply some cell shifting, and other mutations
-      roundKeys[i].ShiftCellsRightInplace();
-      roundKeys[i] += lastKey;
-      roundKeys[i].ShiftColumnsRightInplace();
-      roundKeys[i] ^= lastKey;
+      Key* const roundKey = &roundKeys[i];
+      const Key* const lastKey = &roundKeys[i - 1];
+      DeriveNextRoundKeys<1>(&roundKey, &lastKey);
+    }
+
+    // Derive the constants of this keyset, once for all rounds
+    DeriveReducedRoundKeys(keyset);
+
+    return;
+  }
+
+  template <std::size_t Rounds>
+  template <std::size_t Lanes>
+  void BasicFeistel<Rounds>::DeriveNextRoundKeys(Key* const* roundKeys, const Key* const* lastKeys) {
+    // Each step runs on all lanes before the next one starts, so that their chains overlap
+    for (std::size_t step = 0; step < Kernels::KEY_DERIVATION_STEPS; step++) {
+      for (std::size_t i = 0; i < Lanes; i++) {
+        Kernels::DeriveRoundKeyStep(step, roundKeys[i]->Data(), lastKeys[i]->Data());
+      }
+    }
+
+    return;
+  }
+
+  template <std::size_t Rounds>
+  void BasicFeistel<Rounds>::DeriveReducedRoundKeys(BasicKeyset<Rounds>& keyset) {
+    for (std::size_t i = 0; i < keyset.roundKeys.size(); i++) {
+      keyset.reducedRoundKeys[i] = ReductionFunction(keyset.roundKeys[i]);
+    }
+
+    return;
+  }
+
+  template <std::size_t Rounds>
+  BasicKeyset<Rounds> BasicFeistel<Rounds>::GetNextKeyset() const {
+    return keyset;
+  }
+
+  template <std::size_t Rounds>
+  void BasicFeistel<Rounds>::SetNextKeyset(const BasicKeyset<Rounds>& keyset) {
+    this->keyset = keyset;
+    isInitialized = true;
+
+    return;
+  }
+
+  template <std::size_t Rounds>
+  void BasicFeistel<Rounds>::RollKeyset(BasicKeyset<Rounds>& keyset) {
+    // Mind that GenerateKeyset() clears the keyset before reading its seed, which aliases
+    // the last round key. Existing ciphertexts depend on this, so it stays this way.
+    GenerateKeyset(keyset, keyset.roundKeys.back());
+
+    return;
+  }
+
+  template <std::size_t Rounds>
+  void BasicFeistel<Rounds>::SeedRoll(BasicKeyset<Rounds>& keyset) {
+    // Same as RollKeyset(), including clearing the keyset before reading its seed
+    const Key& seedKey = keyset.roundKeys.back();
+
+    keyset.Reset();
+    keyset = BasicKeyset<Rounds>();
+    keyset.roundKeys[0] = seedKey;
+
+    return;
+  }
+
+  template <std::size_t Rounds>
+  template <std::size_t Lanes>
+  void BasicFeistel<Rounds>::RollKeysetLanes(BasicKeyset<Rounds>* const* keysets) {
+    for (std::size_t i = 0; i < Lanes; i++) {
+      SeedRoll(*keysets[i]);
+    }
+
+    // Each round key depends on the one before it, but not on any other lane
+    for (std::size_t k = 1; k < Rounds; k++) {
+      Key* roundKeys[Lanes];
+      const Key* lastKeys[Lanes];
+      for (std::size_t i = 0; i < Lanes; i++) {
+        roundKeys[i] = &keysets[i]->roundKeys[k];
+        lastKeys[i] = &keysets[i]->roundKeys[k - 1];
+      }
+
+      DeriveNextRoundKeys<Lanes>(roundKeys, lastKeys);
+    }
+
+    for (std::size_t i = 0; i < Lanes; i++) {
+      DeriveReducedRoundKeys(*keysets[i]);
     }
 
     return;
   }
 
-  void Feistel::operator=(const Feistel& other) {
-    roundKeys = other.roundKeys;
+  template <std::size_t Rounds>
+  void BasicFeistel<Rounds>::operator=(const BasicFeistel& other) {
+    keyset = other.keyset;
     isInitialized = other.isInitialized;
 
     return;
@@ -261,10 +588,10 @@ namespace Leonetienne::GCrypt {
 #pragma GCC push_options
 #pragma GCC optimize ("O0")
 #endif
-  void Feistel::ZeroKeyMemory() {
-    for (Key& key : roundKeys) {
-      key.Reset();
-    }
+  template <std::size_t Rounds>
+  void BasicFeistel<Rounds>::ZeroKeyMemory() {
+    keyset.Reset();
+    nextKeyset.Reset();
 
     return;
   }
@@ -274,5 +601,19 @@ namespace Leonetienne::GCrypt {
 #pragma GCC pop_options
 #endif
 
+  // Instantiate templates
+  template class BasicFeistel<N_ROUNDS>;
+
+  template void BasicFeistel<N_ROUNDS>::EncipherLanes<4>(Block*, const BasicKeyset<N_ROUNDS>* const*);
+  template void BasicFeistel<N_ROUNDS>::EncipherLanes<8>(Block*, const BasicKeyset<N_ROUNDS>* const*);
+  template void BasicFeistel<N_ROUNDS>::EncipherLanes<16>(Block*, const BasicKeyset<N_ROUNDS>* const*);
+  template void BasicFeistel<N_ROUNDS>::DecipherLanes<4>(Block*, const BasicKeyset<N_ROUNDS>* const*);
+  template void BasicFeistel<N_ROUNDS>::DecipherLanes<8>(Block*, const BasicKeyset<N_ROUNDS>* const*);
+  template void BasicFeistel<N_ROUNDS>::DecipherLanes<16>(Block*, const BasicKeyset<N_ROUNDS>* const*);
+  template void BasicFeistel<N_ROUNDS>::DecipherLanesAndRoll<4>(Block*, const BasicKeyset<N_ROUNDS>* const*, BasicKeyset<N_ROUNDS>* const*);
+  template void BasicFeistel<N_ROUNDS>::DecipherLanesAndRoll<8>(Block*, const BasicKeyset<N_ROUNDS>* const*, BasicKeyset<N_ROUNDS>* const*);
+  template void BasicFeistel<N_ROUNDS>::DecipherLanesAndRoll<16>(Block*, const BasicKeyset<N_ROUNDS>* const*, BasicKeyset<N_ROUNDS>* const*);
+  template void BasicFeistel<N_ROUNDS>::RollKeysetLanes<4>(BasicKeyset<N_ROUNDS>* const*);
+  template void BasicFeistel<N_ROUNDS>::RollKeysetLanes<8>(BasicKeyset<N_ROUNDS>* const*);
+  template void BasicFeistel<N_ROUNDS>::RollKeysetLanes<16>(BasicKeyset<N_ROUNDS>* const*);
 }
-
@@ -1,3 +1,4 @@
+#include <array>
 #include <iostream>
 #include <vector>
 #include <stdexcept>
@@ -10,58 +11,123 @@ namespace Leonetienne::GCrypt {
   GCipher::GCipher() {
   }
 
-  GCipher::GCipher(const Key& key, const DIRECTION direction) :
-    direction { direction },
-    lastBlock(InitializationVector(key)), // Initialize our lastBlock with some deterministic initial value, based on the key
-    feistel(key)
-  {
-    isInitialized = true;
+  GCipher::GCipher(const Key& key, const DIRECTION direction, const KEY_SCHEDULE keySchedule) {
+    Initialize(key, direction, keySchedule);
     return;
   }
 
-  void GCipher::Initialize(const Key& key, const DIRECTION direction) {
-    feistel = Feistel(key);
-    lastBlock = InitializationVector(key);
+  void GCipher::Initialize(const Key& key, const DIRECTION direction, const KEY_SCHEDULE keySchedule) {
+    cbc.Initialize(key);
     this->direction = direction;
+    this->keySchedule = keySchedule;
+    digestFunction = SelectDigestFunction(direction, keySchedule);
+
+    // Reuse a running producer, if there is one
+    if (keySchedule != KEY_SCHEDULE::LOOKAHEAD) {
+      keysetLookahead.reset();
+    }
+    else if (keysetLookahead) {
+      keysetLookahead->Reseed(key);
+    }
+    else {
+      keysetLookahead = std::make_unique<KeysetLookahead>(key);
+    }
+
     isInitialized = true;
 
     return;
   }
 
+  template <GCipher::DIRECTION digestDirection, GCipher::KEY_SCHEDULE digestKeySchedule>
+  Block GCipher::DigestBlock(const Block& input) {
+
+    if constexpr (digestKeySchedule == KEY_SCHEDULE::LOOKAHEAD) {
+      // Take the keyset of this block from the producer, and hand its slot back afterwards
+      const Block result = cbc.Digest<digestDirection>(input, keysetLookahead->Peek());
+      keysetLookahead->Pop();
+
+      return result;
+    }
+
+    else {
+      return cbc.Digest<digestDirection>(input);
+    }
+  }
+
   Block GCipher::Digest(const Block& input) {
 
     if (!isInitialized) {
       throw std::runtime_error("Attempted to digest data on uninitialized GCipher!");
     }
 
-    switch (direction) {
-      case DIRECTION::ENCIPHER: {
-        // Rename our input to cleartext
-        const Block& cleartext = input;
+    return (this->*digestFunction)(input);
+  }
 
-        // First, xor our cleartext with the last block, and then encipher it
-        Block ciphertext = feistel.Encipher(cleartext ^ lastBlock);
+  void GCipher::DigestInplace(Block* blocks, const std::size_t n) {
 
-        // Now set our lastBlock to the ciphertext of this block
-        lastBlock = ciphertext;
+    if (!isInitialized) {
+      throw std::runtime_error("Attempted to digest data on uninitialized GCipher!");
+    }
 
-        // Now return the ciphertext
-        return ciphertext;
+    if (direction == DIRECTION::ENCIPHER) {
+      for (std::size_t i = 0; i < n; i++) {
+        blocks[i] = (this->*digestFunction)(blocks[i]);
       }
 
-      case DIRECTION::DECIPHER: {
-        // Rename our input into ciphertext
-        const Block& ciphertext = input;
+      return;
+    }
 
-        // First, decipher our ciphertext, and then xor it with our last block
-        Block cleartext = feistel.Decipher(ciphertext) ^ lastBlock;
+    if (keySchedule == KEY_SCHEDULE::INLINE) {
+      cbc.DecipherInplace(blocks, n);
+      return;
+    }
 
-        // Now set our lastBLock to the ciphertext of this block
-        lastBlock = ciphertext;
+    // Take the keysets of each run from the producer
+    constexpr std::size_t lanes = CipherModes::CBC<N_ROUNDS>::DECIPHER_LANES;
+    std::array<Keyset, lanes> keysets;
+    std::array<const Keyset*, lanes> keysetPtrs;
+    for (std::size_t j = 0; j < lanes; j++) {
+      keysetPtrs[j] = &keysets[j];
+    }
 
-        // Now return the cleartext
-        return cleartext;
+    std::size_t i = 0;
+    for (; i + lanes <= n; i += lanes) {
+      for (Keyset& keyset : keysets) {
+        keyset = keysetLookahead->Peek();
+        keysetLookahead->Pop();
       }
+
+      cbc.Decipher<lanes>(blocks + i, keysetPtrs.data());
+    }
+
+    for (Keyset& keyset : keysets) {
+      keyset.Reset();
+    }
+
+    // Whatever does not fill a whole run
+    for (; i < n; i++) {
+      blocks[i] = (this->*digestFunction)(blocks[i]);
+    }
+
+    return;
+  }
+
+  void GCipher::DigestInplace(std::vector<Block>& blocks) {
+    DigestInplace(blocks.data(), blocks.size());
+    return;
+  }
+
+  GCipher::DigestFunction GCipher::SelectDigestFunction(const DIRECTION direction, const KEY_SCHEDULE keySchedule) {
+    switch (keySchedule) {
+      case KEY_SCHEDULE::INLINE:
+        return (direction == DIRECTION::ENCIPHER) ?
+          &GCipher::DigestBlock<DIRECTION::ENCIPHER, KEY_SCHEDULE::INLINE> :
+          &GCipher::DigestBlock<DIRECTION::DECIPHER, KEY_SCHEDULE::INLINE>;
+
+      case KEY_SCHEDULE::LOOKAHEAD:
+        return (direction == DIRECTION::ENCIPHER) ?
+          &GCipher::DigestBlock<DIRECTION::ENCIPHER, KEY_SCHEDULE::LOOKAHEAD> :
+          &GCipher::DigestBlock<DIRECTION::DECIPHER, KEY_SCHEDULE::LOOKAHEAD>;
     }
 
     throw std::runtime_error("Unreachable branch reached.");
@@ -73,19 +139,83 @@ namespace Leonetienne::GCrypt {
       throw std::runtime_error("Attempted to set key on uninitialized GCipher!");
     }
 
-    feistel.SetKey(key);
+    if (keySchedule == KEY_SCHEDULE::LOOKAHEAD) {
+      // Continue the running producer from the new key
+      keysetLookahead->Reseed(key);
+    }
+    else {
+      cbc.SetKey(key);
+    }
 
     return;
   }
 
   void GCipher::operator=(const GCipher& other) {
     direction = other.direction;
-    feistel = other.feistel;
-    lastBlock = other.lastBlock;
+    keySchedule = other.keySchedule;
+    digestFunction = other.digestFunction;
+    cbc = other.cbc;
+
+    // Continue from the keyset other would use next, reusing a running producer
+    if (!other.keysetLookahead) {
+      keysetLookahead.reset();
+    }
+    else if (keysetLookahead) {
+      keysetLookahead->Reseed(other.keysetLookahead->Peek());
+    }
+    else {
+      keysetLookahead = std::make_unique<KeysetLookahead>(other.keysetLookahead->Peek());
+    }
+
     isInitialized = other.isInitialized;
 
     return;
   }
 
-}
+  GCipherState GCipher::SaveState() const {
+
+    if (!isInitialized) {
+      throw std::runtime_error("Attempted to save the state of an uninitialized GCipher!");
+    }
+
+    Keyset nextKeyset;
+    Block lastBlock;
+    cbc.ExportState(nextKeyset, lastBlock);
+
+    // The lookahead is ahead of the own keyset
+    if (keysetLookahead) {
+      nextKeyset = keysetLookahead->Peek();
+    }
 
+    const GCipherState state(direction, nextKeyset, lastBlock);
+    nextKeyset.Reset();
+
+    return state;
+  }
+
+  void GCipher::RestoreState(const GCipherState& state, const KEY_SCHEDULE keySchedule) {
+    Keyset nextKeyset = state.GetNextKeyset();
+
+    cbc.ImportState(nextKeyset, state.GetLastBlock());
+    direction = state.GetDirection();
+    this->keySchedule = keySchedule;
+    digestFunction = SelectDigestFunction(direction, keySchedule);
+
+    // Reuse a running producer, if there is one
+    if (keySchedule != KEY_SCHEDULE::LOOKAHEAD) {
+      keysetLookahead.reset();
+    }
+    else if (keysetLookahead) {
+      keysetLookahead->Reseed(nextKeyset);
+    }
+    else {
+      keysetLookahead = std::make_unique<KeysetLookahead>(nextKeyset);
+    }
+    nextKeyset.Reset();
+
+    isInitialized = true;
+
+    return;
+  }
+
+}
@@ -0,0 +1,184 @@
+#include "GCrypt/GCipherState.h"
+#include "GCrypt/Feistel.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace {
+  using Leonetienne::GCrypt::Block;
+  using Leonetienne::GCrypt::N_ROUNDS;
+
+  // A header block, the last block, and one block per round key
+  constexpr std::size_t BLOB_SIZE = (2 + N_ROUNDS) * Block::BLOCK_SIZE;
+}
+
+namespace Leonetienne::GCrypt {
+
+  GCipherState::GCipherState() {
+  }
+
+  GCipherState::GCipherState(const CIPHER_DIRECTION direction, const Keyset& nextKeyset, const Block& lastBlock) {
+    Block header;
+    header.Reset();
+    header[0] = MAGIC;
+    header[1] = VERSION;
+    header[2] = (std::uint32_t)direction;
+    header[3] = (std::uint32_t)N_ROUNDS;
+
+    bytes.reserve(BLOB_SIZE);
+    bytes.append((const char*)(const void*)header.Data(), Block::BLOCK_SIZE);
+    bytes.append((const char*)(const void*)lastBlock.Data(), Block::BLOCK_SIZE);
+    for (const Key& roundKey : nextKeyset.roundKeys) {
+      bytes.append((const char*)(const void*)roundKey.Data(), Block::BLOCK_SIZE);
+    }
+
+    return;
+  }
+
+  GCipherState::GCipherState(const std::string& bytes) :
+    bytes(bytes)
+  {
+    // The destructor does not run, if the constructor throws. So wipe the copy by hand.
+    try {
+      Validate();
+    }
+    catch (...) {
+      ZeroStateMemory();
+      throw;
+    }
+
+    return;
+  }
+
+  GCipherState::GCipherState(const GCipherState& other) :
+    bytes(other.bytes)
+  {
+  }
+
+  GCipherState::~GCipherState() {
+    ZeroStateMemory();
+    return;
+  }
+
+  void GCipherState::operator=(const GCipherState& other) {
+    ZeroStateMemory();
+    bytes = other.bytes;
+
+    return;
+  }
+
+  const std::string& GCipherState::GetBytes() const {
+    return bytes;
+  }
+
+  bool GCipherState::IsEmpty() const {
+    return bytes.empty();
+  }
+
+  void GCipherState::Validate() const {
+    if (bytes.size() < Block::BLOCK_SIZE) {
+      throw std::runtime_error("Attempted to use a GCipherState that is empty, or truncated!");
+    }
+
+    const Block header = GetBlock(0);
+    if ((header[0] != MAGIC) || (header[1] != VERSION)) {
+      throw std::runtime_error("Attempted to use data that is not a GCipherState!");
+    }
+
+    if ((header[3] != N_ROUNDS) || (bytes.size() != BLOB_SIZE)) {
+      throw std::runtime_error("Attempted to use a GCipherState of a different number of rounds!");
+    }
+
+    if ((header[2] != (std::uint32_t)CIPHER_DIRECTION::ENCIPHER) && (header[2] != (std::uint32_t)CIPHER_DIRECTION::DECIPHER)) {
+      throw std::runtime_error("Attempted to use a GCipherState of an unknown direction!");
+    }
+
+    return;
+  }
+
+  Block GCipherState::GetBlock(const std::size_t i) const {
+    Block block;
+    memcpy(block.Data(), bytes.data() + i * Block::BLOCK_SIZE, Block::BLOCK_SIZE);
+
+    return block;
+  }
+
+  CIPHER_DIRECTION GCipherState::GetDirection() const {
+    Validate();
+    return (CIPHER_DIRECTION)GetBlock(0)[2];
+  }
+
+  Keyset GCipherState::GetNextKeyset() const {
+    Validate();
+
+    Keyset keyset;
+    for (std::size_t i = 0; i < keyset.roundKeys.size(); i++) {
+      keyset.roundKeys[i] = GetBlock(2 + i);
+    }
+    Feistel::DeriveReducedRoundKeys(keyset);
+
+    return keyset;
+  }
+
+  Block GCipherState::GetLastBlock() const {
+    Validate();
+    return GetBlock(1);
+  }
+
+  void GCipherState::WriteToFile(const std::string& path) const {
+    std::ofstream ofs(path, std::ios::binary);
+    if (!ofs.good()) {
+      throw std::runtime_error("Unable to open ofilestream!");
+    }
+
+    ofs.write(bytes.data(), bytes.size());
+
+    return;
+  }
+
+  GCipherState GCipherState::LoadFromFile(const std::string& path) {
+    std::ifstream ifs(path, std::ios::binary | std::ios::ate);
+    if (!ifs.good()) {
+      throw std::runtime_error("Unable to open ifilestream!");
+    }
+
+    const std::streamoff size = ifs.tellg();
+    if (size < 0) {
+      throw std::runtime_error("Unable to read ifilestream!");
+    }
+    ifs.seekg(0);
+
+    // Read straight into the state, so that no copy of the key material is left behind.
+    // Sized up front, so the string never reallocates. Should Validate() throw, the destructor wipes it.
+    GCipherState state;
+    state.bytes.resize((std::size_t)size);
+    if (!ifs.read(&state.bytes[0], size)) {
+      throw std::runtime_error("Unable to read ifilestream!");
+    }
+
+    state.Validate();
+
+    return state;
+  }
+
+  // These pragmas only work for MSVC and g++, as far as i know. Beware!!!
+#if defined _WIN32 || defined _WIN64
+#pragma optimize("", off )
+#elif defined __GNUG__
+#pragma GCC push_options
+#pragma GCC optimize ("O0")
+#endif
+  void GCipherState::ZeroStateMemory() {
+    std::fill(bytes.begin(), bytes.end(), '\0');
+    bytes.clear();
+
+    return;
+  }
+#if defined _WIN32 || defined _WIN64
+#pragma optimize("", on )
+#elif defined __GNUG__
+#pragma GCC pop_options
+#endif
+
+}
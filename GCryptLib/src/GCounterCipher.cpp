@@ -0,0 +1,88 @@
+#include "GCrypt/GCounterCipher.h"
+#include "GCrypt/ThreadJoiner.h"
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+
+namespace Leonetienne::GCrypt {
+
+  GCounterCipher::GCounterCipher() {
+  }
+
+  GCounterCipher::GCounterCipher(const Key& key, const Block& nonce) {
+    Initialize(key, nonce);
+    return;
+  }
+
+  void GCounterCipher::Initialize(const Key& key, const Block& nonce) {
+    counter.Initialize(key, nonce);
+    isInitialized = true;
+
+    return;
+  }
+
+  Block GCounterCipher::Digest(const Block& input) {
+    if (!isInitialized) {
+      throw std::runtime_error("Attempted to digest data on uninitialized GCounterCipher!");
+    }
+
+    return counter.Digest<CIPHER_DIRECTION::ENCIPHER>(input);
+  }
+
+  void GCounterCipher::DigestInplace(Block* blocks, const std::size_t n, std::size_t nThreads) {
+    if (!isInitialized) {
+      throw std::runtime_error("Attempted to digest data on uninitialized GCounterCipher!");
+    }
+
+    if (n == 0) {
+      return;
+    }
+
+    if (nThreads == 0) {
+      nThreads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+    }
+    nThreads = std::max<std::size_t>(std::min(nThreads, n / MIN_BLOCKS_PER_THREAD), 1);
+
+    const std::size_t rangeSize = (n + nThreads - 1) / nThreads;
+    const std::size_t firstIndex = counter.GetPosition();
+
+    // Every range knows its keystream position right away. The last range gets digested on this thread.
+    const auto digestRange = [this, blocks](const std::size_t start, const std::size_t size, const std::size_t startIndex) {
+      for (std::size_t i = 0; i < size; i++) {
+        blocks[start + i] ^= counter.KeystreamBlock(startIndex + i);
+      }
+    };
+
+    ThreadJoiner workers;
+    for (std::size_t start = 0; start < n; start += rangeSize) {
+      const std::size_t size = std::min(rangeSize, n - start);
+
+      if (start + size == n) {
+        digestRange(start, size, firstIndex + start);
+        break;
+      }
+
+      workers.Spawn(digestRange, start, size, firstIndex + start);
+    }
+    workers.Join();
+
+    counter.Seek(firstIndex + n);
+
+    return;
+  }
+
+  void GCounterCipher::DigestInplace(std::vector<Block>& blocks, const std::size_t nThreads) {
+    DigestInplace(blocks.data(), blocks.size(), nThreads);
+    return;
+  }
+
+  void GCounterCipher::Seek(const std::size_t blockIndex) {
+    counter.Seek(blockIndex);
+    return;
+  }
+
+  std::size_t GCounterCipher::GetPosition() const {
+    return counter.GetPosition();
+  }
+
+}
@@ -1,6 +1,11 @@
 #include "GCrypt/GHash.h"
 #include "GCrypt/Util.h"
 #include "GCrypt/InitializationVector.h"
+#include "GCrypt/Feistel.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
 #include <vector>
 
 namespace Leonetienne::GCrypt {
@@ -14,22 +19,59 @@ namespace Leonetienne::GCrypt {
     Key key;
     key.FromByteString("nsoCZfvdqpRkeVTt9wzvPR3TT26peOW9E2kTHh3pdPCq2M7BpskvUljJHSrobUTI");
 
-    cipher = GCipher(
-      // The key really does not matter, as it gets changed
-      // each time before digesting anything.
-      key,
-      GCipher::DIRECTION::ENCIPHER
-    );
+    // The key really does not matter, as each block gets enciphered with its own keyset.
+    // It only decides the initialization vector of the chaining.
+    lastBlock = InitializationVector(key);
 
     return;
   }
 
   void GHash::Digest(const Block& data) {
-    // Set the cipher key to the current data to be hashed
-    cipher.SetKey(data);
+    // The cipher key is the current data to be hashed
+    Keyset keyset;
+    Feistel::GenerateKeyset(keyset, data);
 
-    // Encipher the current block, and matrix-mult it with the current hashsum
-    block ^= cipher.Digest(data);
+    DigestWithKeyset(data, keyset);
+
+    keyset.Reset();
+
+    return;
+  }
+
+  void GHash::Digest(const Block* blocks, const std::size_t n) {
+    if (n == 0) {
+      return;
+    }
+
+    // The keyset of each block does not depend on the chain.
+    // So it gets generated while the block before it goes through the rounds.
+    // Only the first one gets generated on its own.
+    std::array<Keyset, 2> keysets;
+    Feistel::GenerateKeyset(keysets[0], blocks[0]);
+
+    for (std::size_t i = 0; i + 1 < n; i++) {
+      const Keyset& keyset = keysets[i % 2];
+      Keyset& nextKeyset = keysets[(i + 1) % 2];
+
+      const Block ciphertext = Feistel::EncipherAndGenerateKeyset(blocks[i] ^ lastBlock, keyset, nextKeyset, blocks[i + 1]);
+      lastBlock = ciphertext;
+      block ^= ciphertext;
+    }
+
+    DigestWithKeyset(blocks[n - 1], keysets[(n - 1) % 2]);
+
+    for (Keyset& keyset : keysets) {
+      keyset.Reset();
+    }
+
+    return;
+  }
+
+  void GHash::DigestWithKeyset(const Block& data, const Keyset& keyset) {
+    // Encipher the current block in CBC mode, and matrix-mult it with the current hashsum
+    const Block ciphertext = Feistel::Encipher(data ^ lastBlock, keyset);
+    lastBlock = ciphertext;
+    block ^= ciphertext;
 
     return;
   }
@@ -38,6 +80,79 @@ namespace Leonetienne::GCrypt {
     return block;
   }
 
+  void GHash::Update(const char* bytes, std::size_t n) {
+    if (isFinalized) {
+      throw std::runtime_error("Attempted to update a GHash that has already been finalized!");
+    }
+
+    nBytesFed += n;
+
+    // Fill up the buffer, and digest it whenever it holds a whole run of blocks.
+    // The blocks of the buffer are contiguous bytes.
+    static_assert(sizeof(Block) == Block::BLOCK_SIZE, "Blocks must not be padded");
+    char* const bufferBytes = (char*)(void*)buffer.data();
+    constexpr std::size_t bufferSize = BUFFER_BLOCKS * Block::BLOCK_SIZE;
+
+    while (n > 0) {
+      const std::size_t nTaken = std::min(n, bufferSize - nBuffered);
+      memcpy(bufferBytes + nBuffered, bytes, nTaken);
+      nBuffered += nTaken;
+      bytes += nTaken;
+      n -= nTaken;
+
+      if (nBuffered == bufferSize) {
+        Digest(buffer.data(), BUFFER_BLOCKS);
+        nBuffered = 0;
+      }
+    }
+
+    return;
+  }
+
+  void GHash::Update(const std::string& bytes) {
+    Update(bytes.data(), bytes.length());
+    return;
+  }
+
+  Block GHash::Finalize() {
+    if (isFinalized) {
+      throw std::runtime_error("Attempted to finalize a GHash twice!");
+    }
+
+    // The last, partial block gets zero-padded, just like ReadFileToBlocks() and StringToBitblocks() do
+    const std::size_t nBlocks = (nBuffered + Block::BLOCK_SIZE - 1) / Block::BLOCK_SIZE;
+    memset((char*)(void*)buffer.data() + nBuffered, 0, nBlocks * Block::BLOCK_SIZE - nBuffered);
+    Digest(buffer.data(), nBlocks);
+
+    Digest(LengthBlock(nBytesFed));
+
+    for (Block& bufferedBlock : buffer) {
+      bufferedBlock.Reset();
+    }
+    nBuffered = 0;
+    isFinalized = true;
+
+    return block;
+  }
+
+  Block GHash::HashFile(const std::string& filepath) {
+    std::ifstream ifs(filepath, std::ios::binary);
+
+    if (!ifs.good()) {
+      throw std::runtime_error("Unable to open ifilestream!");
+    }
+
+    GHash hasher;
+    std::vector<char> chunk(FILE_READ_SIZE);
+
+    while (ifs.good()) {
+      ifs.read(chunk.data(), chunk.size());
+      hasher.Update(chunk.data(), ifs.gcount());
+    }
+
+    return hasher.Finalize();
+  }
+
   Block GHash::CalculateHashsum(const std::vector<Block>& data, std::size_t n_bytes) {
 
     // If we have no supplied n_bytes, let's just assume sizeof(data).
@@ -49,12 +164,19 @@ namespace Leonetienne::GCrypt {
     GHash hasher;
 
     // Digest all blocks
-    for (const Block& block : data) {
-      hasher.Digest(block);
-    }
+    hasher.Digest(data.data(), data.size());
 
     // Add an additional block, containing the length of the input
+    const Block lengthBlock = LengthBlock(n_bytes);
+
+    // Digest the length block
+    hasher.Digest(lengthBlock);
+
+    // Return the total hashsum
+    return hasher.GetHashsum();
+  }
 
+  Block GHash::LengthBlock(const std::size_t n_bytes) {
     // Here it is actually good to use a binary string ("10011"),
     // because std::size_t is not fixed to 32-bits. It may aswell
     // be 64 bits, depending on the platform.
@@ -74,11 +196,7 @@ namespace Leonetienne::GCrypt {
     Block lengthBlock;
     lengthBlock.FromTextString(ss.str());
 
-    // Digest the length block
-    hasher.Digest(lengthBlock);
-
-    // Return the total hashsum
-    return hasher.GetHashsum();
+    return lengthBlock;
   }
 
   Block GHash::HashString(const std::string& str) {
@@ -89,7 +207,12 @@ namespace Leonetienne::GCrypt {
   }
 
   void GHash::operator=(const GHash& other) {
-    cipher = other.cipher;
+    lastBlock = other.lastBlock;
+    block = other.block;
+    buffer = other.buffer;
+    nBuffered = other.nBuffered;
+    nBytesFed = other.nBytesFed;
+    isFinalized = other.isFinalized;
 
     return;
   }
@@ -0,0 +1,211 @@
+#include "GCrypt/GTreeHash.h"
+#include "GCrypt/GHash.h"
+#include "GCrypt/ThreadJoiner.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+  using namespace Leonetienne::GCrypt;
+
+  // Which kind of node a header belongs to
+  constexpr std::uint32_t NODE_LEAF = 0x6661656C;
+  constexpr std::uint32_t NODE_PARENT = 0x746E7270;
+  constexpr std::uint32_t NODE_ROOT = 0x746F6F72;
+
+  // Header: magic, version, node kind, leaf size, and a value depending on the node kind
+  Block NodeHeader(const std::uint32_t kind, const std::size_t value) {
+    Block header;
+    header.Reset();
+    header[0] = GTreeHash::MAGIC;
+    header[1] = GTreeHash::VERSION;
+    header[2] = kind;
+    header[3] = (std::uint32_t)GTreeHash::LEAF_SIZE;
+    header[4] = (std::uint32_t)(value & 0xFFFFFFFF);
+    header[5] = (std::uint32_t)((std::uint64_t)value >> 32);
+
+    return header;
+  }
+
+  // A leaf is the GHash of its header, followed by its bytes.
+  // The leaf index in the header keeps equal leaves at different positions apart.
+  Block HashLeaf(const char* bytes, const std::size_t n, const std::size_t leafIndex) {
+    GHash hasher;
+    hasher.Update((const char*)(const void*)NodeHeader(NODE_LEAF, leafIndex).Data(), Block::BLOCK_SIZE);
+    hasher.Update(bytes, n);
+
+    return hasher.Finalize();
+  }
+
+  // Hashes a range of leaves. Only the last leaf of the range may be short.
+  void HashLeaves(const char* bytes, const std::size_t n, const std::size_t firstLeafIndex, Block* digests) {
+    for (std::size_t offset = 0, i = 0; offset < n; offset += GTreeHash::LEAF_SIZE, i++) {
+      digests[i] = HashLeaf(bytes + offset, std::min(GTreeHash::LEAF_SIZE, n - offset), firstLeafIndex + i);
+    }
+
+    return;
+  }
+
+  // A parent is the GHash of its header, and the digests of both children
+  Block HashParent(const Block& left, const Block& right) {
+    GHash hasher;
+    hasher.Digest(NodeHeader(NODE_PARENT, 0));
+    hasher.Digest(left);
+    hasher.Digest(right);
+
+    return hasher.GetHashsum();
+  }
+}
+
+namespace Leonetienne::GCrypt {
+
+  GTreeHash::GTreeHash(std::size_t nThreads) {
+    if (nThreads == 0) {
+      nThreads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+    }
+    this->nThreads = nThreads;
+
+    batch.resize(nThreads * LEAVES_PER_THREAD * LEAF_SIZE);
+
+    return;
+  }
+
+  void GTreeHash::Update(const char* bytes, std::size_t n) {
+    if (isFinalized) {
+      throw std::runtime_error("Attempted to update a GTreeHash that has already been finalized!");
+    }
+
+    nBytesFed += n;
+
+    while (n > 0) {
+      const std::size_t nTaken = std::min(n, batch.size() - nBatched);
+      memcpy(batch.data() + nBatched, bytes, nTaken);
+      nBatched += nTaken;
+      bytes += nTaken;
+      n -= nTaken;
+
+      if (nBatched == batch.size()) {
+        HashBatch();
+      }
+    }
+
+    return;
+  }
+
+  void GTreeHash::Update(const std::string& bytes) {
+    Update(bytes.data(), bytes.length());
+    return;
+  }
+
+  Block GTreeHash::Finalize() {
+    if (isFinalized) {
+      throw std::runtime_error("Attempted to finalize a GTreeHash twice!");
+    }
+
+    HashBatch();
+
+    // Join the remaining subtrees from right to left. Only the rightmost ones may be incomplete.
+    GHash root;
+    root.Digest(NodeHeader(NODE_ROOT, nBytesFed));
+
+    if (!subtrees.empty()) {
+      Block digest = subtrees.back().digest;
+      for (std::size_t i = subtrees.size() - 1; i > 0; i--) {
+        digest = HashParent(subtrees[i - 1].digest, digest);
+      }
+
+      root.Digest(digest);
+    }
+
+    subtrees.clear();
+    std::fill(batch.begin(), batch.end(), 0);
+    nBatched = 0;
+    isFinalized = true;
+
+    return root.GetHashsum();
+  }
+
+  void GTreeHash::HashBatch() {
+    if (nBatched == 0) {
+      return;
+    }
+
+    const std::size_t nBatchLeaves = (nBatched + LEAF_SIZE - 1) / LEAF_SIZE;
+    std::vector<Block> digests(nBatchLeaves);
+
+    // Each thread hashes a range of whole leaves. The last range gets hashed on this thread.
+    const std::size_t nWorkers = std::min(nThreads, nBatchLeaves);
+    const std::size_t leavesPerRange = (nBatchLeaves + nWorkers - 1) / nWorkers;
+    const std::size_t rangeSize = leavesPerRange * LEAF_SIZE;
+
+    ThreadJoiner workers;
+    for (std::size_t start = 0; start < nBatched; start += rangeSize) {
+      const std::size_t size = std::min(rangeSize, nBatched - start);
+      const std::size_t firstLeaf = start / LEAF_SIZE;
+
+      if (start + size == nBatched) {
+        HashLeaves(batch.data() + start, size, nLeaves + firstLeaf, digests.data() + firstLeaf);
+        break;
+      }
+
+      workers.Spawn(HashLeaves, batch.data() + start, size, nLeaves + firstLeaf, digests.data() + firstLeaf);
+    }
+    workers.Join();
+
+    for (const Block& digest : digests) {
+      PushLeaf(digest);
+    }
+
+    nLeaves += nBatchLeaves;
+    nBatched = 0;
+
+    return;
+  }
+
+  void GTreeHash::PushLeaf(const Block& digest) {
+    Subtree subtree { digest, 0 };
+
+    // Two complete subtrees of the same size make one complete subtree, twice as big
+    while ((!subtrees.empty()) && (subtrees.back().level == subtree.level)) {
+      subtree.digest = HashParent(subtrees.back().digest, subtree.digest);
+      subtree.level++;
+      subtrees.pop_back();
+    }
+
+    subtrees.emplace_back(subtree);
+
+    return;
+  }
+
+  Block GTreeHash::CalculateHashsum(const char* bytes, const std::size_t n, const std::size_t nThreads) {
+    GTreeHash hasher(nThreads);
+    hasher.Update(bytes, n);
+
+    return hasher.Finalize();
+  }
+
+  Block GTreeHash::CalculateHashsum(const std::string& bytes, const std::size_t nThreads) {
+    return CalculateHashsum(bytes.data(), bytes.length(), nThreads);
+  }
+
+  Block GTreeHash::HashFile(const std::string& filepath, const std::size_t nThreads) {
+    std::ifstream ifs(filepath, std::ios::binary);
+
+    if (!ifs.good()) {
+      throw std::runtime_error("Unable to open ifilestream!");
+    }
+
+    GTreeHash hasher(nThreads);
+    std::vector<char> chunk(GHash::FILE_READ_SIZE);
+
+    while (ifs.good()) {
+      ifs.read(chunk.data(), chunk.size());
+      hasher.Update(chunk.data(), ifs.gcount());
+    }
+
+    return hasher.Finalize();
+  }
+
+}
@@ -1,26 +1,36 @@
 #include "GCrypt/GWrapper.h"
 #include "GCrypt/GCipher.h"
+#include "GCrypt/ParallelDecipher.h"
+#include "GCrypt/HashingCipher.h"
+#include "GCrypt/Feistel.h"
+#include "GCrypt/InitializationVector.h"
 #include "GCrypt/Util.h"
 #include <vector>
+#include <fstream>
+#include <sstream>
+
+namespace {
+  using namespace Leonetienne::GCrypt;
+
+  // How many whole blocks a file of nBytes holds.
+  // Checkpoint indices get built, and looked up, by this count.
+  std::size_t BlockCountOf(const std::size_t nBytes) {
+    return nBytes / Block::BLOCK_SIZE;
+  }
+}
 
 namespace Leonetienne::GCrypt {
 
   std::string GWrapper::EncryptString(
       const std::string& cleartext,
-      const Key& key)
+      const Key& key,
+      const MODE mode)
   {
     // Recode the ascii-string to bits
     const std::vector<Block> cleartext_blocks = StringToBitblocks(cleartext);
 
-    // Create cipher instance
-    GCipher cipher(key, GCipher::DIRECTION::ENCIPHER);
-
     // Encrypt all blocks
-    std::vector<Block> ciphertext_blocks;
-
-    for (const Block& clearBlock : cleartext_blocks) {
-      ciphertext_blocks.emplace_back(cipher.Digest(clearBlock));
-    }
+    const std::vector<Block> ciphertext_blocks = CipherBlocks(cleartext_blocks, key, GCipher::DIRECTION::ENCIPHER, mode);
 
     // Recode the ciphertext blocks to a hex-string
     std::stringstream ss;
@@ -34,7 +44,8 @@ namespace Leonetienne::GCrypt {
 
   std::string GWrapper::DecryptString(
       const std::string& ciphertext,
-      const Key& key)
+      const Key& key,
+      const MODE mode)
   {
     // Make sure our ciphertext is a multiple of block size
     if (ciphertext.length() % Block::BLOCK_SIZE*2 != 0) { // Two chars per byte
@@ -51,14 +62,8 @@ namespace Leonetienne::GCrypt {
       ciphertext_blocks.emplace_back(block);
     }
 
-    // Create cipher instance
-    GCipher cipher(key, GCipher::DIRECTION::DECIPHER);
-
     // Decrypt all blocks
-    std::vector<Block> cleartext_blocks;
-    for (const Block& cipherBlock : ciphertext_blocks) {
-      cleartext_blocks.emplace_back(cipher.Digest(cipherBlock));
-    }
+    const std::vector<Block> cleartext_blocks = CipherBlocks(ciphertext_blocks, key, GCipher::DIRECTION::DECIPHER, mode);
 
     // Recode the cleartext blocks to bytes
     std::stringstream ss;
@@ -74,23 +79,15 @@ namespace Leonetienne::GCrypt {
       const std::string& filename_in,
       const std::string& filename_out,
       const Key& key,
-      bool printProgressReport)
+      bool printProgressReport,
+      const MODE mode)
   {
     try {
       // Read the file to blocks
       const std::vector<Block> cleartext_blocks = ReadFileToBlocks(filename_in);
 
-      // Encrypt our cleartext blocks
-      std::vector<Block> ciphertext_blocks;
-      ciphertext_blocks.reserve(cleartext_blocks.size());
-
-      // Create cipher instance
-      GCipher cipher(key, GCipher::DIRECTION::ENCIPHER);
-
       // Encrypt all blocks
-      for (const Block& clearBlock : cleartext_blocks) {
-        ciphertext_blocks.emplace_back(cipher.Digest(clearBlock));
-      }
+      const std::vector<Block> ciphertext_blocks = CipherBlocks(cleartext_blocks, key, GCipher::DIRECTION::ENCIPHER, mode);
 
       // Write our ciphertext blocks to file
       WriteBlocksToFile(filename_out, ciphertext_blocks);
@@ -106,26 +103,89 @@ namespace Leonetienne::GCrypt {
       const std::string& filename_in,
       const std::string& filename_out,
       const Key& key,
-      bool printProgressReport)
+      bool printProgressReport,
+      const MODE mode)
   {
     try {
       // Read the file to blocks
-      const std::vector<Block> ciphertext_blocks = ReadFileToBlocks(filename_in);
+      std::vector<Block> blocks = ReadFileToBlocks(filename_in);
 
-      // Decrypt our cleartext blocks
-      std::vector<Block> cleartext_blocks;
-      cleartext_blocks.reserve(ciphertext_blocks.size());
+      // Decrypt all blocks, in place, on all cores
+      if (mode == MODE::COUNTER) {
+        // The ciphertext leads with its nonce
+        if (blocks.empty()) {
+          return false;
+        }
+        const Block nonce = blocks.front();
+        blocks.erase(blocks.begin());
 
-      // Create cipher instance
-      GCipher cipher(key, GCipher::DIRECTION::DECIPHER);
+        GCounterCipher(key, nonce).DigestInplace(blocks);
+      }
+      else {
+        // If the file has been indexed, every range starts at its nearest checkpoint
+        ParallelDecipher::DecipherInplace(blocks, key, LoadIndexOf(filename_in, blocks.size()));
+      }
 
-      // Decrypt all blocks
-      for (const Block& cipherBlock : ciphertext_blocks) {
-        cleartext_blocks.emplace_back(cipher.Digest(cipherBlock));
+      // Write our cleartext blocks to file
+      WriteBlocksToFile(filename_out, blocks);
+
+      return true;
+    }
+    catch (std::runtime_error&) {
+      return false;
+    }
+  }
+
+  bool GWrapper::EncryptAndDigestFile(
+      const std::string& filename_in,
+      const std::string& filename_out,
+      const Key& key,
+      Block& hashsum)
+  {
+    try {
+      // Read the file to blocks
+      std::vector<Block> blocks = ReadFileToBlocks(filename_in);
+
+      // Encrypt all blocks in place, whilst the ciphertext gets hashed on the side
+      HashingCipher cipher(key, GCipher::DIRECTION::ENCIPHER);
+      for (Block& block : blocks) {
+        block = cipher.Digest(block);
+      }
+      hashsum = cipher.Finish();
+
+      // Write our ciphertext blocks to file
+      WriteBlocksToFile(filename_out, blocks);
+
+      return true;
+    }
+    catch (std::runtime_error&) {
+      return false;
+    }
+  }
+
+  bool GWrapper::DecryptAndVerifyFile(
+      const std::string& filename_in,
+      const std::string& filename_out,
+      const Key& key,
+      const Block& hashsum)
+  {
+    try {
+      // Read the file to blocks
+      std::vector<Block> blocks = ReadFileToBlocks(filename_in);
+
+      // Decrypt all blocks in place, whilst the ciphertext gets hashed on the side
+      HashingCipher cipher(key, GCipher::DIRECTION::DECIPHER);
+      for (Block& block : blocks) {
+        block = cipher.Digest(block);
+      }
+
+      // Don't release any cleartext of a corrupted file
+      if (cipher.Finish() != hashsum) {
+        return false;
       }
 
       // Write our cleartext blocks to file
-      WriteBlocksToFile(filename_out, cleartext_blocks);
+      WriteBlocksToFile(filename_out, blocks);
 
       return true;
     }
@@ -134,22 +194,235 @@ namespace Leonetienne::GCrypt {
     }
   }
 
+  bool GWrapper::IndexFile(
+      const std::string& filename_encrypted,
+      const Key& key,
+      const std::size_t interval)
+  {
+    try {
+      // The index only depends on the key, and on the number of blocks
+      std::ifstream ifs(filename_encrypted, std::ios::binary | std::ios::ate);
+      if (!ifs.good()) {
+        return false;
+      }
+      const std::size_t nBlocks = BlockCountOf(ifs.tellg());
+      ifs.close();
+
+      CheckpointIndex::Build(key, nBlocks, interval).WriteToFile(CheckpointIndex::SidecarPath(filename_encrypted));
+
+      return true;
+    }
+    catch (std::runtime_error&) {
+      return false;
+    }
+  }
+
+  std::string GWrapper::DecryptRange(
+      const std::string& filename_encrypted,
+      const std::size_t offset,
+      const std::size_t length,
+      const Key& key,
+      const MODE mode)
+  {
+    std::ifstream ifs(filename_encrypted, std::ios::binary | std::ios::ate);
+    if (!ifs.good()) {
+      throw std::runtime_error("Unable to open ifilestream!");
+    }
+
+    // Files encrypted in counter mode lead with their nonce
+    const std::size_t headerSize = (mode == MODE::COUNTER) ? Block::BLOCK_SIZE : 0;
+    if ((std::size_t)ifs.tellg() < headerSize) {
+      throw std::runtime_error("Leonetienne::GCrypt::GWrapper::DecryptRange() received a counter mode file without a nonce.");
+    }
+
+    // Clip the range to the file
+    const std::size_t fileSize = (std::size_t)ifs.tellg() - headerSize;
+    if ((length == 0) || (offset >= fileSize)) {
+      return "";
+    }
+    const std::size_t end = (length > fileSize - offset) ? fileSize : offset + length;
+
+    // Find the blocks covering the range.
+    // CBC needs the ciphertext block before the first one, too.
+    const std::size_t firstBlock = offset / Block::BLOCK_SIZE;
+    const std::size_t lastBlock = (end - 1) / Block::BLOCK_SIZE;
+    const std::size_t readFrom = ((firstBlock > 0) && (mode == MODE::CBC)) ? firstBlock - 1 : firstBlock;
+
+    Block nonce;
+    if (mode == MODE::COUNTER) {
+      ifs.seekg(0);
+      ifs.read((char*)(void*)nonce.Data(), Block::BLOCK_SIZE);
+    }
+
+    std::vector<Block> blocks(lastBlock - readFrom + 1);
+    ifs.seekg(headerSize + readFrom * Block::BLOCK_SIZE);
+    for (Block& block : blocks) {
+      block.Reset();
+      ifs.read((char*)(void*)block.Data(), Block::BLOCK_SIZE);
+    }
+    ifs.close();
+
+    // In counter mode, just jump to the first block
+    if (mode == MODE::COUNTER) {
+      GCounterCipher cipher(key, nonce);
+      cipher.Seek(firstBlock);
+      cipher.DigestInplace(blocks);
+
+      return BitblocksToBytes(blocks).substr(offset - firstBlock * Block::BLOCK_SIZE, end - offset);
+    }
+
+    Block lastCiphertext = (firstBlock > 0) ? blocks.front() : Block(InitializationVector(key));
+    if (firstBlock > 0) {
+      blocks.erase(blocks.begin());
+    }
+
+    // Jump to the nearest checkpoint, if this file has been indexed
+    const CheckpointIndex index = LoadIndexOf(filename_encrypted, BlockCountOf(fileSize));
+    Keyset keyset = index.KeysetAt(firstBlock, key);
+
+    // Decipher just the covering blocks
+    for (Block& block : blocks) {
+      const Block ciphertext = block;
+      block = Feistel::Decipher(ciphertext, keyset) ^ lastCiphertext;
+      lastCiphertext = ciphertext;
+
+      Feistel::RollKeyset(keyset);
+    }
+    keyset.Reset();
+
+    // Cut the requested bytes out of the covering blocks
+    return BitblocksToBytes(blocks).substr(offset - firstBlock * Block::BLOCK_SIZE, end - offset);
+  }
+
+  bool GWrapper::AppendToEncryptedFile(
+      const std::string& filename_in,
+      const std::string& filename_encrypted,
+      GCipherState& state)
+  {
+    try {
+      if (state.GetDirection() != GCipher::DIRECTION::ENCIPHER) {
+        return false;
+      }
+
+      // Read the file to blocks
+      std::vector<Block> blocks = ReadFileToBlocks(filename_in);
+
+      // Encrypt all blocks in place, continuing the chain
+      GCipher cipher;
+      cipher.RestoreState(state);
+      for (Block& block : blocks) {
+        block = cipher.Digest(block);
+      }
+
+      // Append our ciphertext blocks to the encrypted file
+      std::ofstream ofs(filename_encrypted, std::ios::binary | std::ios::app);
+      if (!ofs.good()) {
+        return false;
+      }
+
+      for (const Block& block : blocks) {
+        ofs.write((const char*)(const void*)block.Data(), Block::BLOCK_SIZE);
+      }
+
+      if (!ofs.good()) {
+        return false;
+      }
+
+      state = cipher.SaveState();
+
+      return true;
+    }
+    catch (std::runtime_error&) {
+      return false;
+    }
+  }
+
+  GCipherState GWrapper::StateAtEndOfFile(
+      const std::string& filename_encrypted,
+      const Key& key)
+  {
+    std::ifstream ifs(filename_encrypted, std::ios::binary | std::ios::ate);
+    if (!ifs.good()) {
+      throw std::runtime_error("Unable to open ifilestream!");
+    }
+
+    const std::size_t nBlocks = BlockCountOf(ifs.tellg());
+
+    // An empty file continues from the very start
+    if (nBlocks == 0) {
+      return GCipher(key, GCipher::DIRECTION::ENCIPHER).SaveState();
+    }
+
+    // The chain continues from the last ciphertext block
+    Block lastBlock;
+    ifs.seekg((nBlocks - 1) * Block::BLOCK_SIZE);
+    ifs.read((char*)(void*)lastBlock.Data(), Block::BLOCK_SIZE);
+    ifs.close();
+
+    // The key schedule continues from the keyset of the block after the last one
+    Keyset keyset = LoadIndexOf(filename_encrypted, nBlocks).KeysetAt(nBlocks, key);
+    const GCipherState state(GCipher::DIRECTION::ENCIPHER, keyset, lastBlock);
+    keyset.Reset();
+
+    return state;
+  }
+
+  CheckpointIndex GWrapper::LoadIndexOf(
+      const std::string& filename_encrypted,
+      const std::size_t nBlocks)
+  {
+    try {
+      const CheckpointIndex index = CheckpointIndex::LoadFromFile(CheckpointIndex::SidecarPath(filename_encrypted));
+
+      // An index left over from a different file is of no use
+      if (index.GetBlockCount() == nBlocks) {
+        return index;
+      }
+    }
+    catch (std::runtime_error&) {
+      // No index. Roll the key schedule from the start.
+    }
+
+    return CheckpointIndex();
+  }
+
   std::vector<Block> GWrapper::CipherBlocks(
       const std::vector<Block>& data,
       const Key& key,
-      const GCipher::DIRECTION direction)
+      const GCipher::DIRECTION direction,
+      const MODE mode)
   {
+    // Counter mode digests all blocks independently, so let it use all cores.
+    // Every encryption gets a fresh nonce, which leads the ciphertext.
+    if (mode == MODE::COUNTER) {
+      if (direction == GCipher::DIRECTION::ENCIPHER) {
+        const Block nonce = Key::Random();
+
+        std::vector<Block> digested;
+        digested.reserve(data.size() + 1);
+        digested.emplace_back(nonce);
+        digested.insert(digested.end(), data.begin(), data.end());
+        GCounterCipher(key, nonce).DigestInplace(digested.data() + 1, data.size());
+
+        return digested;
+      }
+
+      if (data.empty()) {
+        throw std::runtime_error("Leonetienne::GCrypt::GWrapper::CipherBlocks() received counter mode ciphertext without a nonce.");
+      }
+
+      std::vector<Block> digested(data.begin() + 1, data.end());
+      GCounterCipher(key, data.front()).DigestInplace(digested);
+
+      return digested;
+    }
+
     // Create cipher instance
     GCipher cipher(key, direction);
 
-    std::vector<Block> digested;
-    digested.reserve(data.size());
-
     // Digest all our blocks
-    for (const Block& block : data) {
-      Block digestedBlock = cipher.Digest(block);
-      digested.emplace_back(digestedBlock);
-    }
+    std::vector<Block> digested = data;
+    cipher.DigestInplace(digested);
 
     // Return it
     return digested;
@@ -0,0 +1,139 @@
+#include "GCrypt/HashingCipher.h"
+#include <stdexcept>
+
+namespace Leonetienne::GCrypt {
+
+  HashingCipher::HashingCipher(const Key& key, const GCipher::DIRECTION direction) :
+    cipher(key, direction),
+    direction { direction }
+  {
+    hasherThread = std::thread(&HashingCipher::Hash, this);
+    return;
+  }
+
+  HashingCipher::~HashingCipher() {
+    if (!isFinished) {
+      StopHasher();
+    }
+
+    return;
+  }
+
+  Block HashingCipher::Digest(const Block& input) {
+    if (isFinished) {
+      throw std::runtime_error("Attempted to digest data on a finished HashingCipher!");
+    }
+
+    const Block output = cipher.Digest(input);
+
+    Enqueue((direction == GCipher::DIRECTION::ENCIPHER) ? output : input);
+
+    return output;
+  }
+
+  Block HashingCipher::Finish() {
+    if (isFinished) {
+      throw std::runtime_error("Attempted to finish a HashingCipher twice!");
+    }
+
+    StopHasher();
+    isFinished = true;
+
+    // Terminate the hash with the size of the ciphertext, just like GHash::CalculateHashsum() does
+    hasher.Digest(GHash::LengthBlock(head.load(std::memory_order_relaxed) * Block::BLOCK_SIZE));
+
+    return hasher.GetHashsum();
+  }
+
+  void HashingCipher::Enqueue(const Block& ciphertext) {
+    const std::size_t produced = head.load(std::memory_order_relaxed);
+
+    const auto hasFreeSlot = [this, produced]() {
+      return produced - tail.load() < QUEUE_CAPACITY;
+    };
+
+    // Wait for a free slot. Spin first, as the hasher is rarely far behind.
+    for (std::size_t i = 0; (i < SPINS_BEFORE_BLOCKING) && (!hasFreeSlot()); i++) {
+      std::this_thread::yield();
+    }
+
+    if (!hasFreeSlot()) {
+      // Announce blocking before checking one last time, so that the hasher either sees it, or frees the slot in time.
+      // Both threads store, then load, sequentially consistent, so no wakeup gets lost.
+      std::unique_lock<std::mutex> lock(mutex);
+      digesterBlocked.store(true);
+      wakeDigester.wait(lock, hasFreeSlot);
+      digesterBlocked.store(false);
+    }
+
+    queue[produced % QUEUE_CAPACITY] = ciphertext;
+    head.store(produced + 1);
+
+    // Wake the hasher, if it went to sleep waiting for this block
+    if (hasherBlocked.load()) {
+      std::lock_guard<std::mutex> lock(mutex);
+      wakeHasher.notify_one();
+    }
+
+    return;
+  }
+
+  void HashingCipher::StopHasher() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      finished.store(true);
+    }
+    wakeHasher.notify_one();
+    hasherThread.join();
+
+    return;
+  }
+
+  void HashingCipher::Hash() {
+    std::size_t consumed = tail.load(std::memory_order_relaxed);
+
+    while (true) {
+      // Wait for the next block. Once finished is set, head is final.
+      if (head.load(std::memory_order_acquire) == consumed) {
+        if ((finished.load(std::memory_order_acquire)) && (head.load(std::memory_order_acquire) == consumed)) {
+          break;
+        }
+
+        WaitForBlock(consumed);
+        continue;
+      }
+
+      hasher.Digest(queue[consumed % QUEUE_CAPACITY]);
+      tail.store(++consumed);
+
+      // Wake the digesting thread, if it went to sleep waiting for this slot
+      if (digesterBlocked.load()) {
+        std::lock_guard<std::mutex> lock(mutex);
+        wakeDigester.notify_one();
+      }
+    }
+
+    return;
+  }
+
+  void HashingCipher::WaitForBlock(const std::size_t consumed) {
+    const auto canContinue = [this, consumed]() {
+      return (head.load() != consumed) || (finished.load());
+    };
+
+    for (std::size_t i = 0; i < SPINS_BEFORE_BLOCKING; i++) {
+      if (canContinue()) {
+        return;
+      }
+      std::this_thread::yield();
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    hasherBlocked.store(true);
+    wakeHasher.wait(lock, canContinue);
+    hasherBlocked.store(false);
+
+    return;
+  }
+
+}
@@ -6,7 +6,12 @@ namespace Leonetienne::GCrypt {
   InitializationVector::InitializationVector(const Block& seed) {
     // We'll generate our initialization vector by encrypting our seed with itself as a key
     // iv = E(M=seed, K=seed)
-    iv = Feistel(seed).Encipher(seed);
+    // This is a single block, so no keyset gets rolled for a next one.
+    Keyset keyset;
+    Feistel::GenerateKeyset(keyset, seed);
+    iv = Feistel::Encipher(seed, keyset);
+
+    keyset.Reset();
   }
 
   InitializationVector::operator Block() const {
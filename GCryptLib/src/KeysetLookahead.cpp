@@ -0,0 +1,179 @@
+#include "GCrypt/KeysetLookahead.h"
+
+namespace Leonetienne::GCrypt {
+
+  template <std::size_t Rounds>
+  BasicKeysetLookahead<Rounds>::BasicKeysetLookahead(const Key& seedKey) {
+    BasicKeyset<Rounds> first;
+    BasicFeistel<Rounds>::GenerateKeyset(first, seedKey);
+
+    producer = std::thread(&BasicKeysetLookahead::Produce, this, first);
+    first.Reset();
+
+    return;
+  }
+
+  template <std::size_t Rounds>
+  BasicKeysetLookahead<Rounds>::BasicKeysetLookahead(const BasicKeyset<Rounds>& first) {
+    producer = std::thread(&BasicKeysetLookahead::Produce, this, first);
+    return;
+  }
+
+  template <std::size_t Rounds>
+  BasicKeysetLookahead<Rounds>::~BasicKeysetLookahead() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stop.store(true);
+    }
+    wakeProducer.notify_one();
+    producer.join();
+
+    for (BasicKeyset<Rounds>& keyset : ring) {
+      keyset.Reset();
+    }
+    pendingSeed.Reset();
+
+    return;
+  }
+
+  template <std::size_t Rounds>
+  void BasicKeysetLookahead<Rounds>::Produce(BasicKeyset<Rounds> next) {
+    std::size_t produced = head.load(std::memory_order_relaxed);
+
+    while (!stop.load(std::memory_order_relaxed)) {
+      // Continue from a new seed. The consumer waits in Reseed() meanwhile, so nothing gets read from the ring.
+      if (reseedRequested.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        const std::size_t consumed = tail.load(std::memory_order_relaxed);
+        for (; produced > consumed; produced--) {
+          ring[(produced - 1) % CAPACITY].Reset();
+        }
+        head.store(produced);
+
+        next = pendingSeed;
+        pendingSeed.Reset();
+        reseedRequested.store(false);
+        wakeConsumer.notify_all();
+
+        continue;
+      }
+
+      // Wait for a free slot
+      if (produced - tail.load(std::memory_order_acquire) == CAPACITY) {
+        WaitForSlot(produced);
+        continue;
+      }
+
+      ring[produced % CAPACITY] = next;
+      head.store(++produced);
+
+      // Wake the consumer, if it went to sleep waiting for this keyset
+      if (consumerBlocked.load()) {
+        std::lock_guard<std::mutex> lock(mutex);
+        wakeConsumer.notify_all();
+      }
+
+      BasicFeistel<Rounds>::RollKeyset(next);
+    }
+
+    next.Reset();
+
+    return;
+  }
+
+  template <std::size_t Rounds>
+  void BasicKeysetLookahead<Rounds>::WaitForSlot(const std::size_t produced) {
+    const auto canContinue = [this, produced]() {
+      return
+        (produced - tail.load() < CAPACITY) ||
+        (stop.load()) ||
+        (reseedRequested.load());
+    };
+
+    for (std::size_t i = 0; i < SPINS_BEFORE_BLOCKING; i++) {
+      if (canContinue()) {
+        return;
+      }
+      std::this_thread::yield();
+    }
+
+    // Announce blocking before checking one last time, so that Pop() either sees it, or frees the slot in time.
+    // Both sides store, then load, sequentially consistent, so no wakeup gets lost.
+    std::unique_lock<std::mutex> lock(mutex);
+    producerBlocked.store(true);
+    wakeProducer.wait(lock, canContinue);
+    producerBlocked.store(false);
+
+    return;
+  }
+
+  template <std::size_t Rounds>
+  const BasicKeyset<Rounds>& BasicKeysetLookahead<Rounds>::Peek() const {
+    const std::size_t consumed = tail.load(std::memory_order_relaxed);
+    const auto isReady = [this, consumed]() {
+      return head.load() != consumed;
+    };
+
+    // Wait for the producer to catch up. Spin first, as it is rarely far behind.
+    for (std::size_t i = 0; (i < SPINS_BEFORE_BLOCKING) && (!isReady()); i++) {
+      std::this_thread::yield();
+    }
+
+    if (!isReady()) {
+      std::unique_lock<std::mutex> lock(mutex);
+      consumerBlocked.store(true);
+      wakeConsumer.wait(lock, isReady);
+      consumerBlocked.store(false);
+    }
+
+    return ring[consumed % CAPACITY];
+  }
+
+  template <std::size_t Rounds>
+  void BasicKeysetLookahead<Rounds>::Pop() {
+    const std::size_t consumed = tail.load(std::memory_order_relaxed);
+
+    // Make sure the slot is filled, before zeroing and releasing it
+    Peek();
+    ring[consumed % CAPACITY].Reset();
+
+    tail.store(consumed + 1);
+
+    // Wake the producer, if it went to sleep waiting for this slot
+    if (producerBlocked.load()) {
+      std::lock_guard<std::mutex> lock(mutex);
+      wakeProducer.notify_one();
+    }
+
+    return;
+  }
+
+  template <std::size_t Rounds>
+  void BasicKeysetLookahead<Rounds>::Reseed(const Key& seedKey) {
+    BasicKeyset<Rounds> first;
+    BasicFeistel<Rounds>::GenerateKeyset(first, seedKey);
+
+    Reseed(first);
+    first.Reset();
+
+    return;
+  }
+
+  template <std::size_t Rounds>
+  void BasicKeysetLookahead<Rounds>::Reseed(const BasicKeyset<Rounds>& first) {
+    std::unique_lock<std::mutex> lock(mutex);
+
+    pendingSeed = first;
+    reseedRequested.store(true);
+    wakeProducer.notify_one();
+
+    // Wait for the producer to drop everything it computed from the old seed
+    wakeConsumer.wait(lock, [this]() { return !reseedRequested.load(); });
+
+    return;
+  }
+
+  // Instantiate templates
+  template class BasicKeysetLookahead<N_ROUNDS>;
+}
@@ -0,0 +1,137 @@
+#include "GCrypt/MultiBufferCipher.h"
+#include "GCrypt/Feistel.h"
+#include "GCrypt/InitializationVector.h"
+#include <stdexcept>
+
+namespace Leonetienne::GCrypt {
+
+  template <std::size_t Lanes>
+  MultiBufferCipher<Lanes>::MultiBufferCipher(const GCipher::DIRECTION direction)
+    :
+    direction { direction } {
+
+    for (std::size_t i = 0; i < Lanes; i++) {
+      ZeroLaneMemory(i);
+      active[i] = false;
+    }
+
+    return;
+  }
+
+  template <std::size_t Lanes>
+  MultiBufferCipher<Lanes>::~MultiBufferCipher() {
+    for (std::size_t i = 0; i < Lanes; i++) {
+      ZeroLaneMemory(i);
+    }
+  }
+
+  template <std::size_t Lanes>
+  void MultiBufferCipher<Lanes>::Initialize(const std::size_t lane, const Key& key) {
+    if (lane >= Lanes) {
+      throw std::out_of_range("Attempted to initialize a lane that does not exist!");
+    }
+
+    // Same as CipherModes::CBC::Initialize()
+    Feistel::GenerateKeyset(keysets[lane], key);
+    lastBlocks[lane] = InitializationVector(key);
+    active[lane] = true;
+
+    return;
+  }
+
+  template <std::size_t Lanes>
+  void MultiBufferCipher<Lanes>::Release(const std::size_t lane) {
+    if (lane >= Lanes) {
+      throw std::out_of_range("Attempted to release a lane that does not exist!");
+    }
+
+    ZeroLaneMemory(lane);
+    active[lane] = false;
+
+    return;
+  }
+
+  template <std::size_t Lanes>
+  bool MultiBufferCipher<Lanes>::IsActive(const std::size_t lane) const {
+    return active.at(lane);
+  }
+
+  template <std::size_t Lanes>
+  void MultiBufferCipher<Lanes>::Digest(Block* blocks) {
+    // The rounds always run on all lanes. Released lanes run on zeros, and their results get dropped.
+    std::array<Block, Lanes> work;
+    std::array<Keyset*, Lanes> keysetPtrs;
+
+    for (std::size_t i = 0; i < Lanes; i++) {
+      keysetPtrs[i] = &keysets[i];
+
+      if (!active[i]) {
+        work[i].Reset();
+      }
+      else if (direction == GCipher::DIRECTION::ENCIPHER) {
+        work[i] = blocks[i] ^ lastBlocks[i];
+      }
+      else {
+        work[i] = blocks[i];
+      }
+    }
+
+    if (direction == GCipher::DIRECTION::ENCIPHER) {
+      Feistel::EncipherLanes<Lanes>(work.data(), keysetPtrs.data());
+
+      for (std::size_t i = 0; i < Lanes; i++) {
+        if (active[i]) {
+          lastBlocks[i] = work[i];
+          blocks[i] = work[i];
+        }
+      }
+    }
+    else {
+      Feistel::DecipherLanes<Lanes>(work.data(), keysetPtrs.data());
+
+      for (std::size_t i = 0; i < Lanes; i++) {
+        if (active[i]) {
+          const Block cleartext = work[i] ^ lastBlocks[i];
+          lastBlocks[i] = blocks[i];
+          blocks[i] = cleartext;
+        }
+      }
+    }
+
+    // Every lane moves on to the keyset of its next block
+    Feistel::RollKeysetLanes<Lanes>(keysetPtrs.data());
+
+    return;
+  }
+
+  template <std::size_t Lanes>
+  void MultiBufferCipher<Lanes>::Digest(std::array<Block, Lanes>& blocks) {
+    Digest(blocks.data());
+    return;
+  }
+
+  // These pragmas only work for MSVC and g++, as far as i know. Beware!!!
+#if defined _WIN32 || defined _WIN64
+#pragma optimize("", off )
+#elif defined __GNUG__
+#pragma GCC push_options
+#pragma GCC optimize ("O0")
+#endif
+  template <std::size_t Lanes>
+  void MultiBufferCipher<Lanes>::ZeroLaneMemory(const std::size_t lane) {
+    keysets[lane].Reset();
+    lastBlocks[lane].Reset();
+
+    return;
+  }
+#if defined _WIN32 || defined _WIN64
+#pragma optimize("", on )
+#elif defined __GNUG__
+#pragma GCC pop_options
+#endif
+
+  // Instantiate templates
+  template class MultiBufferCipher<4>;
+  template class MultiBufferCipher<8>;
+  template class MultiBufferCipher<16>;
+}
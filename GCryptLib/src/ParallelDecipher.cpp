@@ -0,0 +1,115 @@
+#include "GCrypt/ParallelDecipher.h"
+#include "GCrypt/BasicGCipher.h"
+#include "GCrypt/Feistel.h"
+#include "GCrypt/InitializationVector.h"
+#include "GCrypt/ThreadJoiner.h"
+#include <algorithm>
+#include <thread>
+
+namespace {
+  using namespace Leonetienne::GCrypt;
+
+  // Deciphers a range of blocks in place.
+  // lastBlock is the ciphertext block preceding the range, keyset is the keyset of its first block.
+  void DecipherRange(Block* blocks, const std::size_t n, Block lastBlock, Keyset keyset) {
+    // Within the range, runs of consecutive blocks get deciphered side by side
+    CipherModes::CBC<N_ROUNDS> cbc;
+    cbc.ImportState(keyset, lastBlock);
+    cbc.DecipherInplace(blocks, n);
+
+    keyset.Reset();
+
+    return;
+  }
+}
+
+namespace Leonetienne::GCrypt {
+
+  void ParallelDecipher::DecipherInplace(Block* blocks, const std::size_t n, const Key& key, std::size_t nThreads) {
+    DecipherInplace(blocks, n, key, CheckpointIndex(), nThreads);
+    return;
+  }
+
+  void ParallelDecipher::DecipherInplace(Block* blocks, const std::size_t n, const Key& key, const CheckpointIndex& index, std::size_t nThreads) {
+    if (n == 0) {
+      return;
+    }
+
+    if (nThreads == 0) {
+      nThreads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+    }
+    nThreads = std::max<std::size_t>(std::min(nThreads, n / MIN_BLOCKS_PER_THREAD), 1);
+
+    const std::size_t rangeSize = (n + nThreads - 1) / nThreads;
+
+    // Before anything gets overwritten, remember the ciphertext block preceding each range
+    std::vector<Block> rangePredecessors;
+    rangePredecessors.reserve(nThreads);
+    rangePredecessors.emplace_back(InitializationVector(key));
+    for (std::size_t start = rangeSize; start < n; start += rangeSize) {
+      rangePredecessors.emplace_back(blocks[start - 1]);
+    }
+
+    // An index only has checkpoints if its stream is longer than one interval
+    const bool seedFromIndex = index.GetBlockCount() > index.GetInterval();
+
+    // Get the keyset at the start of each range, and hand that range off.
+    // With checkpoints, each range restores its own from the nearest one. Otherwise, it gets rolled up to here.
+    // The last range gets deciphered on this thread.
+    Keyset keyset;
+    if (!seedFromIndex) {
+      Feistel::GenerateKeyset(keyset, key);
+    }
+
+    // Declared after everything the workers reference, so that it joins them first
+    ThreadJoiner workers;
+    std::size_t start = 0;
+    for (std::size_t range = 0; range < rangePredecessors.size(); range++) {
+      const std::size_t size = std::min(rangeSize, n - start);
+      const bool isLast = start + size == n;
+
+      if (seedFromIndex) {
+        const auto decipherFromIndex = [blocks, start, size, &rangePredecessors, range, &index, &key]() {
+          DecipherRange(blocks + start, size, rangePredecessors[range], index.KeysetAt(start, key));
+        };
+
+        if (isLast) {
+          decipherFromIndex();
+          break;
+        }
+
+        workers.Spawn(decipherFromIndex);
+        start += size;
+        continue;
+      }
+
+      if (isLast) {
+        DecipherRange(blocks + start, size, rangePredecessors[range], keyset);
+        break;
+      }
+
+      workers.Spawn(DecipherRange, blocks + start, size, rangePredecessors[range], keyset);
+
+      for (std::size_t i = 0; i < size; i++) {
+        Feistel::RollKeyset(keyset);
+      }
+      start += size;
+    }
+
+    workers.Join();
+    keyset.Reset();
+
+    return;
+  }
+
+  void ParallelDecipher::DecipherInplace(std::vector<Block>& blocks, const Key& key, const std::size_t nThreads) {
+    DecipherInplace(blocks.data(), blocks.size(), key, nThreads);
+    return;
+  }
+
+  void ParallelDecipher::DecipherInplace(std::vector<Block>& blocks, const Key& key, const CheckpointIndex& index, const std::size_t nThreads) {
+    DecipherInplace(blocks.data(), blocks.size(), key, index, nThreads);
+    return;
+  }
+
+}
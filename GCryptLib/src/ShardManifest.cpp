@@ -0,0 +1,227 @@
+#include "GCrypt/ShardManifest.h"
+#include "GCrypt/CheckpointIndex.h"
+#include "GCrypt/Feistel.h"
+#include "GCrypt/InitializationVector.h"
+#include "GCrypt/Util.h"
+#include <fstream>
+#include <stdexcept>
+
+namespace {
+  // Identifies manifest files: "GCSM"
+  constexpr std::uint32_t MANIFEST_MAGIC = 0x4D534347;
+  constexpr std::uint32_t MANIFEST_VERSION = 1;
+
+  // Splits a size_t over two block cells
+  void WriteSize(Leonetienne::GCrypt::Block& block, const std::size_t index, const std::size_t value) {
+    block[index] = (std::uint32_t)(value & 0xFFFFFFFF);
+    block[index + 1] = (std::uint32_t)((std::uint64_t)value >> 32);
+    return;
+  }
+
+  std::size_t ReadSize(const Leonetienne::GCrypt::Block& block, const std::size_t index) {
+    return (std::size_t)(block[index] | ((std::uint64_t)block[index + 1] << 32));
+  }
+}
+
+namespace Leonetienne::GCrypt {
+
+  ShardManifest::ShardManifest() {
+  }
+
+  ShardManifest ShardManifest::Plan(const std::string& filename_encrypted, const Key& key, const std::size_t nShards) {
+    if (nShards == 0) {
+      throw std::invalid_argument("Attempted to plan a decryption of 0 shards!");
+    }
+
+    std::ifstream ifs(filename_encrypted, std::ios::binary | std::ios::ate);
+    if (!ifs.good()) {
+      throw std::runtime_error("Unable to open ifilestream!");
+    }
+
+    ShardManifest manifest;
+    manifest.nBlocks = (std::size_t)ifs.tellg() / Block::BLOCK_SIZE;
+
+    const std::size_t shardSize = std::max<std::size_t>((manifest.nBlocks + nShards - 1) / nShards, 1);
+
+    // Roll the key schedule through the whole file once, and take a snapshot at the start of each shard
+    Keyset keyset;
+    Feistel::GenerateKeyset(keyset, key);
+
+    for (std::size_t firstBlock = 0; firstBlock < manifest.nBlocks; firstBlock += shardSize) {
+      Shard shard;
+      shard.firstBlock = firstBlock;
+      shard.nBlocks = std::min(shardSize, manifest.nBlocks - firstBlock);
+      shard.checkpoint.Reset();
+      shard.precedingCiphertext.Reset();
+
+      if (firstBlock > 0) {
+        shard.checkpoint = CheckpointIndex::SaveCheckpoint(keyset, key);
+
+        ifs.seekg((firstBlock - 1) * Block::BLOCK_SIZE);
+        ifs.read((char*)(void*)shard.precedingCiphertext.Data(), Block::BLOCK_SIZE);
+      }
+
+      manifest.shards.emplace_back(shard);
+
+      // Roll up to the last block of this shard, so that the next snapshot rolls into the next shard
+      const std::size_t nRolls = (firstBlock > 0) ? shard.nBlocks : shard.nBlocks - 1;
+      for (std::size_t i = 0; i < nRolls; i++) {
+        Feistel::RollKeyset(keyset);
+      }
+    }
+
+    keyset.Reset();
+
+    return manifest;
+  }
+
+  std::size_t ShardManifest::GetShardCount() const {
+    return shards.size();
+  }
+
+  const ShardManifest::Shard& ShardManifest::GetShard(const std::size_t shard) const {
+    return shards.at(shard);
+  }
+
+  std::size_t ShardManifest::GetBlockCount() const {
+    return nBlocks;
+  }
+
+  void ShardManifest::PrepareOutputFile(const std::string& filename_out) const {
+    std::ofstream ofs(filename_out, std::ios::binary | std::ios::trunc);
+
+    if (!ofs.good()) {
+      throw std::runtime_error("Unable to open ofilestream!");
+    }
+
+    // Writing the last byte sizes the file
+    if (nBlocks > 0) {
+      ofs.seekp(nBlocks * Block::BLOCK_SIZE - 1);
+      ofs.put('\0');
+    }
+
+    ofs.close();
+
+    return;
+  }
+
+  bool ShardManifest::DecryptShard(const std::size_t shardIndex, const std::string& filename_encrypted, const std::string& filename_out, const Key& key) const {
+    try {
+      const Shard& shard = shards.at(shardIndex);
+
+      // Read this shard's ciphertext
+      std::ifstream ifs(filename_encrypted, std::ios::binary);
+      if (!ifs.good()) {
+        return false;
+      }
+
+      std::vector<Block> blocks(shard.nBlocks);
+      ifs.seekg(shard.firstBlock * Block::BLOCK_SIZE);
+      for (Block& block : blocks) {
+        ifs.read((char*)(void*)block.Data(), Block::BLOCK_SIZE);
+      }
+
+      if (!ifs.good()) {
+        return false;
+      }
+      ifs.close();
+
+      // Pick up the key schedule, and the chaining, where the shard starts
+      Keyset keyset;
+      Block lastCiphertext;
+      if (shard.firstBlock > 0) {
+        keyset = CheckpointIndex::RestoreCheckpoint(shard.checkpoint, key);
+        lastCiphertext = shard.precedingCiphertext;
+      }
+      else {
+        Feistel::GenerateKeyset(keyset, key);
+        lastCiphertext = InitializationVector(key);
+      }
+
+      for (Block& block : blocks) {
+        const Block ciphertext = block;
+        block = Feistel::Decipher(ciphertext, keyset) ^ lastCiphertext;
+        lastCiphertext = ciphertext;
+
+        Feistel::RollKeyset(keyset);
+      }
+      keyset.Reset();
+
+      // Write the cleartext into this shard's place of the output file.
+      // Other shards may be writing to the same file, so do not truncate it.
+      std::fstream ofs(filename_out, std::ios::binary | std::ios::in | std::ios::out);
+      if (!ofs.good()) {
+        return false;
+      }
+
+      ofs.seekp(shard.firstBlock * Block::BLOCK_SIZE);
+      for (const Block& block : blocks) {
+        ofs.write((const char*)(const void*)block.Data(), Block::BLOCK_SIZE);
+      }
+
+      return ofs.good();
+    }
+    catch (std::exception&) {
+      return false;
+    }
+  }
+
+  void ShardManifest::WriteToFile(const std::string& path) const {
+    // The first block is a header, followed by three blocks per shard:
+    // its extent, its checkpoint, and its preceding ciphertext block
+    Block header;
+    header.Reset();
+    header[0] = MANIFEST_MAGIC;
+    header[1] = MANIFEST_VERSION;
+    WriteSize(header, 2, nBlocks);
+    WriteSize(header, 4, shards.size());
+
+    std::vector<Block> blocks;
+    blocks.reserve(shards.size() * 3 + 1);
+    blocks.emplace_back(header);
+
+    for (const Shard& shard : shards) {
+      Block extent;
+      extent.Reset();
+      WriteSize(extent, 0, shard.firstBlock);
+      WriteSize(extent, 2, shard.nBlocks);
+
+      blocks.emplace_back(extent);
+      blocks.emplace_back(shard.checkpoint);
+      blocks.emplace_back(shard.precedingCiphertext);
+    }
+
+    WriteBlocksToFile(path, blocks);
+
+    return;
+  }
+
+  ShardManifest ShardManifest::LoadFromFile(const std::string& path) {
+    const std::vector<Block> blocks = ReadFileToBlocks(path);
+
+    if ((blocks.empty()) || (blocks[0][0] != MANIFEST_MAGIC) || (blocks[0][1] != MANIFEST_VERSION)) {
+      throw std::runtime_error("Attempted to load a file that is not a shard manifest!");
+    }
+
+    ShardManifest manifest;
+    manifest.nBlocks = ReadSize(blocks[0], 2);
+    const std::size_t nShards = ReadSize(blocks[0], 4);
+
+    if (blocks.size() != nShards * 3 + 1) {
+      throw std::runtime_error("Attempted to load a corrupt shard manifest!");
+    }
+
+    for (std::size_t i = 0; i < nShards; i++) {
+      Shard shard;
+      shard.firstBlock = ReadSize(blocks[1 + i*3], 0);
+      shard.nBlocks = ReadSize(blocks[1 + i*3], 2);
+      shard.checkpoint = blocks[2 + i*3];
+      shard.precedingCiphertext = blocks[3 + i*3];
+
+      manifest.shards.emplace_back(shard);
+    }
+
+    return manifest;
+  }
+
+}
@@ -0,0 +1,182 @@
+#include <GCrypt/BasicGCipher.h>
+#include <GCrypt/GCipher.h>
+#include <GCrypt/GCounterCipher.h>
+#include "Catch2.h"
+#include "TestUtil.h"
+
+using namespace Leonetienne::GCrypt;
+
+// Tests that the CBC mode yields exactly what GCipher yields, in both directions
+TEST_CASE(__FILE__"/cbc-equals-gcipher", "[BasicGCipher]") {
+
+  // Setup
+  const Key key = Key::Random();
+  const std::vector<Block> cleartext = RandomBlocks(50);
+
+  // Exercise
+  GCipher cipher(key, GCipher::DIRECTION::ENCIPHER);
+  BasicGCipher<CipherModes::CBC, CIPHER_DIRECTION::ENCIPHER> basicCipher(key);
+
+  std::vector<Block> expected;
+  std::vector<Block> ciphertext;
+  for (const Block& block : cleartext) {
+    expected.emplace_back(cipher.Digest(block));
+    ciphertext.emplace_back(basicCipher.Digest(block));
+  }
+
+  std::vector<Block> decrypted = ciphertext;
+  BasicGCipher<CipherModes::CBC, CIPHER_DIRECTION::DECIPHER>(key).DigestInplace(decrypted);
+
+  // Verify
+  REQUIRE(ciphertext == expected);
+  REQUIRE(decrypted == cleartext);
+}
+
+// Tests that the counter mode yields exactly what GCounterCipher yields
+TEST_CASE(__FILE__"/counter-equals-gcountercipher", "[BasicGCipher]") {
+
+  // Setup
+  const Key key = Key::Random();
+  const Block nonce = Key::Random();
+  const std::vector<Block> cleartext = RandomBlocks(50);
+
+  // Exercise
+  std::vector<Block> expected = cleartext;
+  GCounterCipher(key, nonce).DigestInplace(expected);
+
+  std::vector<Block> ciphertext = cleartext;
+  BasicGCipher<CipherModes::Counter, CIPHER_DIRECTION::ENCIPHER>(key, nonce).DigestInplace(ciphertext);
+
+  std::vector<Block> decrypted = ciphertext;
+  BasicGCipher<CipherModes::Counter, CIPHER_DIRECTION::DECIPHER>(key, nonce).DigestInplace(decrypted);
+
+  // Verify
+  REQUIRE(ciphertext == expected);
+  REQUIRE(decrypted == cleartext);
+}
+
+// Tests that digesting in place continues the stream, just like digesting block by block
+TEST_CASE(__FILE__"/inplace-continues-stream", "[BasicGCipher]") {
+
+  // Setup
+  const Key key = Key::Random();
+  const std::vector<Block> cleartext = RandomBlocks(20);
+
+  BasicGCipher<CipherModes::CBC, CIPHER_DIRECTION::ENCIPHER> sequential(key);
+  std::vector<Block> expected;
+  for (const Block& block : cleartext) {
+    expected.emplace_back(sequential.Digest(block));
+  }
+
+  // Exercise
+  BasicGCipher<CipherModes::CBC, CIPHER_DIRECTION::ENCIPHER> cipher(key);
+  std::vector<Block> blocks = cleartext;
+  blocks[0] = cipher.Digest(blocks[0]);
+  cipher.DigestInplace(blocks.data() + 1, 9);
+  cipher.DigestInplace(blocks.data() + 10, 10);
+
+  // Verify
+  REQUIRE(blocks == expected);
+}
+
+// Tests that deciphering runs of blocks side by side yields exactly what deciphering them one by one yields,
+// for any number of blocks, and either key schedule
+TEST_CASE(__FILE__"/lane-parallel-decipher-equals-digest", "[BasicGCipher]") {
+
+  // Setup
+  const Key key = Key::Random();
+  const std::vector<Block> cleartext = RandomBlocks(21);
+
+  std::vector<Block> ciphertext = cleartext;
+  GCipher(key, GCipher::DIRECTION::ENCIPHER).DigestInplace(ciphertext);
+
+  for (std::size_t n = 0; n <= ciphertext.size(); n++) {
+    const std::vector<Block> prefix(ciphertext.begin(), ciphertext.begin() + n);
+    const std::vector<Block> expected(cleartext.begin(), cleartext.begin() + n);
+
+    // Exercise
+    std::vector<Block> inlined = prefix;
+    GCipher(key, GCipher::DIRECTION::DECIPHER).DigestInplace(inlined);
+
+    std::vector<Block> lookahead = prefix;
+    GCipher(key, GCipher::DIRECTION::DECIPHER, GCipher::KEY_SCHEDULE::LOOKAHEAD).DigestInplace(lookahead);
+
+    std::vector<Block> basic = prefix;
+    BasicGCipher<CipherModes::CBC, CIPHER_DIRECTION::DECIPHER>(key).DigestInplace(basic);
+
+    // Verify
+    REQUIRE(inlined == expected);
+    REQUIRE(lookahead == expected);
+    REQUIRE(basic == expected);
+  }
+}
+
+// Tests that a stream continues correctly after deciphering runs of blocks side by side
+TEST_CASE(__FILE__"/lane-parallel-decipher-continues-stream", "[BasicGCipher]") {
+
+  // Setup
+  const Key key = Key::Random();
+  const std::vector<Block> cleartext = RandomBlocks(30);
+
+  std::vector<Block> ciphertext = cleartext;
+  GCipher(key, GCipher::DIRECTION::ENCIPHER).DigestInplace(ciphertext);
+
+  // Exercise
+  // Mix single blocks, and runs of different lengths
+  GCipher cipher(key, GCipher::DIRECTION::DECIPHER);
+  std::vector<Block> decrypted = ciphertext;
+  decrypted[0] = cipher.Digest(decrypted[0]);
+  cipher.DigestInplace(decrypted.data() + 1, 9);
+  decrypted[10] = cipher.Digest(decrypted[10]);
+  cipher.DigestInplace(decrypted.data() + 11, 19);
+
+  // Verify
+  REQUIRE(decrypted == cleartext);
+}
+
+// Tests that deciphering with explicit keysets works for every lane count
+TEST_CASE(__FILE__"/cbc-decipher-lanes", "[BasicGCipher]") {
+
+  // Setup
+  const Key key = Key::Random();
+  const std::vector<Block> cleartext = RandomBlocks(16);
+
+  std::vector<Block> ciphertext = cleartext;
+  GCipher(key, GCipher::DIRECTION::ENCIPHER).DigestInplace(ciphertext);
+
+  std::vector<Keyset> keysets(16);
+  std::vector<const Keyset*> keysetPtrs;
+  Feistel::GenerateKeyset(keysets[0], key);
+  for (std::size_t i = 1; i < keysets.size(); i++) {
+    keysets[i] = keysets[i - 1];
+    Feistel::RollKeyset(keysets[i]);
+  }
+  for (const Keyset& keyset : keysets) {
+    keysetPtrs.emplace_back(&keyset);
+  }
+
+  // Exercise
+  std::vector<Block> by4 = ciphertext;
+  CipherModes::CBC<N_ROUNDS> cbc4;
+  cbc4.Initialize(key);
+  for (std::size_t i = 0; i < 16; i += 4) {
+    cbc4.Decipher<4>(by4.data() + i, keysetPtrs.data() + i);
+  }
+
+  std::vector<Block> by8 = ciphertext;
+  CipherModes::CBC<N_ROUNDS> cbc8;
+  cbc8.Initialize(key);
+  for (std::size_t i = 0; i < 16; i += 8) {
+    cbc8.Decipher<8>(by8.data() + i, keysetPtrs.data() + i);
+  }
+
+  std::vector<Block> by16 = ciphertext;
+  CipherModes::CBC<N_ROUNDS> cbc16;
+  cbc16.Initialize(key);
+  cbc16.Decipher<16>(by16.data(), keysetPtrs.data());
+
+  // Verify
+  REQUIRE(by4 == cleartext);
+  REQUIRE(by8 == cleartext);
+  REQUIRE(by16 == cleartext);
+}
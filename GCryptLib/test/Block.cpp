@@ -155,6 +155,96 @@ TEST_CASE(__FILE__"/operator*&=", "[Block]") {
   REQUIRE(block1 == block3);
 }
 
+// Computes a matrix product straight by its definition, to test the optimized implementations against
+template <typename T>
+static Basic_Block<T> ReferenceMMul(const Basic_Block<T>& a, const Basic_Block<T>& b) {
+  Basic_Block<T> m;
+  for (std::uint8_t row = 0; row < 4; row++) {
+    for (std::uint8_t column = 0; column < 4; column++) {
+      T sum = 0;
+      for (std::uint8_t k = 0; k < 4; k++) {
+        sum += a.Get(row, k) * b.Get(k, column);
+      }
+      m.Get(row, column) = sum;
+    }
+  }
+  return m;
+}
+
+// Tests that the (possibly vectorized) matrix multiplication matches the definition
+TEST_CASE(__FILE__"/mmul", "[Block]") {
+
+  for (std::size_t i = 0; i < 100; i++) {
+    // Setup
+    const Block a = Key::Random();
+    const Block b = Key::Random();
+
+    // Exercise
+    const Block result = a * b;
+
+    // Verify
+    REQUIRE(result == ReferenceMMul(a, b));
+  }
+}
+
+// Tests that the scalar matrix multiplication matches the definition
+TEST_CASE(__FILE__"/mmul-scalar", "[Block]") {
+
+  for (std::size_t i = 0; i < 100; i++) {
+    // Setup
+    const Block a = Key::Random();
+    const Block b = Key::Random();
+
+    // Exercise
+    const Block result = a.MMulScalar(b);
+
+    // Verify
+    REQUIRE(result == ReferenceMMul(a, b));
+  }
+}
+
+// Tests that the matrix multiplication yields the same results as the scalar implementation
+TEST_CASE(__FILE__"/mmul-same-as-scalar", "[Block]") {
+
+  // Setup
+  Block a;
+  Block b;
+  for (std::size_t i = 0; i < 16; i++) {
+    a.Get(i) = i + 1;
+    b.Get(i) = 0xFFFFFFFF - i*7919;
+  }
+
+  SECTION("Copy") {
+    REQUIRE(a.MMul(b) == a.MMulScalar(b));
+  }
+
+  SECTION("Inplace") {
+    const Block expected = a.MMulScalar(b);
+    a.MMulInplace(b);
+
+    REQUIRE(a == expected);
+  }
+
+  SECTION("Inplace, with itself") {
+    const Block expected = a.MMulScalar(a);
+    a.MMulInplace(a);
+
+    REQUIRE(a == expected);
+  }
+
+  SECTION("Halfblock") {
+    Halfblock ha;
+    Halfblock hb;
+    for (std::size_t i = 0; i < 16; i++) {
+      ha.Get(i) = a.Get(i);
+      hb.Get(i) = b.Get(i);
+    }
+
+    REQUIRE(ha.MMul(hb) == ha.MMulScalar(hb));
+    REQUIRE(ha.MMul(hb) == ReferenceMMul(ha, hb));
+  }
+}
+
 // Tests that operator^ (xor) works
 TEST_CASE(__FILE__"/xor", "[Block]") {
 
@@ -313,6 +403,48 @@ TEST_CASE(__FILE__"/subtraction-undoes-addition", "[Block]") {
   REQUIRE(a == a_plus_b_minus_b);
 }
 
+// Tests that the elementwise operations on halfblocks work, including integer overflows
+TEST_CASE(__FILE__"/halfblock-elementwise-operations", "[Block]") {
+
+  // Setup
+  Halfblock a;
+  Halfblock b;
+  for (std::size_t i = 0; i < 16; i++) {
+    a.Get(i) = 0xFFFF - i * 1024;
+    b.Get(i) = i * 5099;
+  }
+
+  SECTION("Xor") {
+    Halfblock inplace = a;
+    inplace ^= b;
+
+    for (std::size_t i = 0; i < 16; i++) {
+      REQUIRE((a ^ b).Get(i) == (std::uint16_t)(a.Get(i) ^ b.Get(i)));
+      REQUIRE(inplace.Get(i) == (std::uint16_t)(a.Get(i) ^ b.Get(i)));
+    }
+  }
+
+  SECTION("Add") {
+    Halfblock inplace = a;
+    inplace += b;
+
+    for (std::size_t i = 0; i < 16; i++) {
+      REQUIRE((a + b).Get(i) == (std::uint16_t)(a.Get(i) + b.Get(i)));
+      REQUIRE(inplace.Get(i) == (std::uint16_t)(a.Get(i) + b.Get(i)));
+    }
+  }
+
+  SECTION("Subtract") {
+    Halfblock inplace = b;
+    inplace -= a;
+
+    for (std::size_t i = 0; i < 16; i++) {
+      REQUIRE((b - a).Get(i) == (std::uint16_t)(b.Get(i) - a.Get(i)));
+      REQUIRE(inplace.Get(i) == (std::uint16_t)(b.Get(i) - a.Get(i)));
+    }
+  }
+}
+
 // Tests that operator== works correctly
 TEST_CASE(__FILE__"/operator==", "[Block]") {
 
@@ -617,6 +749,83 @@ TEST_CASE(__FILE__"/shift-cells-right-same-as-inplace", "[Block]") {
   REQUIRE(a == initial_a.ShiftCellsRight());
 }
 
+// Tests that arbitrary permutations work
+TEST_CASE(__FILE__"/permute", "[Block]") {
+
+  // Setup
+  const BlockPermutation permutation({ 7, 3, 15, 0, 12, 1, 9, 4, 2, 14, 5, 11, 8, 6, 13, 10 });
+
+  Block block;
+  Halfblock halfblock;
+  for (std::size_t i = 0; i < 16; i++) {
+    block.Get(i) = 0xF0000000 + i;
+    halfblock.Get(i) = 0xF000 + i;
+  }
+
+  // Exercise
+  const Block permutedBlock = block.Permute(permutation);
+  const Halfblock permutedHalfblock = halfblock.Permute(permutation);
+
+  Block permutedBlockInplace = block;
+  permutedBlockInplace.PermuteInplace(permutation);
+
+  Halfblock permutedHalfblockInplace = halfblock;
+  permutedHalfblockInplace.PermuteInplace(permutation);
+
+  // Verify
+  for (std::size_t i = 0; i < 16; i++) {
+    REQUIRE(permutedBlock.Get(i) == block.Get(permutation[i]));
+    REQUIRE(permutedHalfblock.Get(i) == halfblock.Get(permutation[i]));
+  }
+  REQUIRE(permutedBlockInplace == permutedBlock);
+  REQUIRE(permutedHalfblockInplace == permutedHalfblock);
+}
+
+// Tests that the shifts on halfblocks do the same as on full blocks
+TEST_CASE(__FILE__"/halfblock-shifts", "[Block]") {
+
+  // Setup
+  Block block;
+  Halfblock halfblock;
+  for (std::size_t i = 0; i < 16; i++) {
+    block.Get(i) = i;
+    halfblock.Get(i) = i;
+  }
+
+  // Verify
+  for (std::size_t i = 0; i < 16; i++) {
+    REQUIRE(halfblock.ShiftRowsUp().Get(i) == block.ShiftRowsUp().Get(i));
+    REQUIRE(halfblock.ShiftRowsDown().Get(i) == block.ShiftRowsDown().Get(i));
+    REQUIRE(halfblock.ShiftColumnsLeft().Get(i) == block.ShiftColumnsLeft().Get(i));
+    REQUIRE(halfblock.ShiftColumnsRight().Get(i) == block.ShiftColumnsRight().Get(i));
+    REQUIRE(halfblock.ShiftCellsLeft().Get(i) == block.ShiftCellsLeft().Get(i));
+    REQUIRE(halfblock.ShiftCellsRight().Get(i) == block.ShiftCellsRight().Get(i));
+  }
+}
+
+// Tests that a composed permutation does the same as applying its parts one after another
+TEST_CASE(__FILE__"/composed-permutation", "[Block]") {
+
+  // Setup
+  const Block a = Key::Random();
+
+  constexpr BlockPermutation composed =
+    BlockPermutation::ShiftRowsUp()
+      .Then(BlockPermutation::ShiftCellsRight())
+      .Then(BlockPermutation::ShiftColumnsLeft());
+
+  // Exercise
+  const Block b = a.Permute(composed);
+
+  Block c = a;
+  c.ShiftRowsUpInplace();
+  c.ShiftCellsRightInplace();
+  c.ShiftColumnsLeftInplace();
+
+  // Verify
+  REQUIRE(b == c);
+}
+
 // Tests that shifting down undoes shifting up, and vica versa
 TEST_CASE(__FILE__"/shift-down-undoes-shift-up", "[Block]") {
   // Setup
@@ -878,6 +1087,40 @@ TEST_CASE(__FILE__"/bitshift-right-inplace", "[Block]") {
   REQUIRE(a == b);
 }
 
+// Tests that bitshifts on halfblocks work
+TEST_CASE(__FILE__"/halfblock-bitshift", "[Block]") {
+
+  // Setup
+  srand(time(0));
+  std::stringstream ss;
+
+  for (std::size_t i = 0; i < 256; i++) {
+    ss << (rand()%2 == 0 ? '1' : '0');
+  }
+  const std::string originalBits = ss.str();
+  const Halfblock block(originalBits);
+
+  SECTION("Left") {
+    const std::string shiftedBits = originalBits.substr(1) + originalBits[0];
+
+    REQUIRE(block.ShiftBitsLeft().ToBinaryString() == shiftedBits);
+
+    Halfblock inplace = block;
+    inplace.ShiftBitsLeftInplace();
+    REQUIRE(inplace.ToBinaryString() == shiftedBits);
+  }
+
+  SECTION("Right") {
+    const std::string shiftedBits = originalBits[255] + originalBits.substr(0, 255);
+
+    REQUIRE(block.ShiftBitsRight().ToBinaryString() == shiftedBits);
+
+    Halfblock inplace = block;
+    inplace.ShiftBitsRightInplace();
+    REQUIRE(inplace.ToBinaryString() == shiftedBits);
+  }
+}
+
 // Tests that bitshifting undoes itself
 TEST_CASE(__FILE__"/bitshifting-undoes-itself", "[Block]") {
 
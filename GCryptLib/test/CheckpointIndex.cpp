@@ -0,0 +1,99 @@
+#include <GCrypt/CheckpointIndex.h>
+#include <GCrypt/Feistel.h>
+#include <GCrypt/GWrapper.h>
+#include <GCrypt/Util.h>
+#include "Catch2.h"
+#include <cstdio>
+
+using namespace Leonetienne::GCrypt;
+
+// Tests that the keyset at any block equals the keyset rolled from the key
+TEST_CASE(__FILE__"/keyset-at", "[Checkpoint index]") {
+
+  // Setup
+  const Key key = Key::Random();
+  const CheckpointIndex index = CheckpointIndex::Build(key, 50, 8);
+
+  Keyset expected;
+  Feistel::GenerateKeyset(expected, key);
+
+  for (std::size_t block = 0; block < 60; block++) {
+    // Exercise
+    const Keyset keyset = index.KeysetAt(block, key);
+
+    // Verify
+    REQUIRE(keyset.roundKeys == expected.roundKeys);
+    REQUIRE(keyset.reducedRoundKeys == expected.reducedRoundKeys);
+
+    Feistel::RollKeyset(expected);
+  }
+}
+
+// Tests that an index survives being written to, and loaded from a file
+TEST_CASE(__FILE__"/write-load", "[Checkpoint index]") {
+
+  // Setup
+  const Key key = Key::Random();
+  const std::string path = "testAssets/checkpoints.gcidx";
+  const CheckpointIndex index = CheckpointIndex::Build(key, 100, 16);
+
+  // Exercise
+  index.WriteToFile(path);
+  const CheckpointIndex loaded = CheckpointIndex::LoadFromFile(path);
+
+  // Verify
+  REQUIRE(loaded.GetInterval() == 16);
+  REQUIRE(loaded.GetBlockCount() == 100);
+  for (std::size_t block = 0; block < 100; block += 7) {
+    REQUIRE(loaded.KeysetAt(block, key).roundKeys == index.KeysetAt(block, key).roundKeys);
+  }
+}
+
+// Tests that decrypting byte ranges of a file yields the same bytes as decrypting all of it,
+// with and without a checkpoint index
+TEST_CASE(__FILE__"/decrypt-range", "[Checkpoint index]") {
+
+  // Setup
+  const std::string filename_plain = "testAssets/testfile.png";
+  const std::string filename_encrypted = "testAssets/testfile.png.range.crypt";
+  const Key key = Key::FromPassword("Der Affe will Zucker");
+
+  GWrapper::EncryptFile(filename_plain, filename_encrypted, key);
+  std::remove(CheckpointIndex::SidecarPath(filename_encrypted).c_str());
+
+  const std::string cleartext = BitblocksToBytes(ReadFileToBlocks(filename_plain));
+  const std::size_t ranges[][2] = {
+    { 0, 1 },
+    { 0, 64 },
+    { 63, 2 },
+    { 64, 64 },
+    { 1000, 5000 },
+    { 4096 + 17, 300 },
+    { cleartext.size() - 10, 100 },
+    { cleartext.size(), 10 },
+    { 0, std::string::npos },
+    { 4096 + 17, std::string::npos },
+  };
+
+  SECTION("Without index") {
+    for (const auto& range : ranges) {
+      // Exercise
+      const std::string decrypted = GWrapper::DecryptRange(filename_encrypted, range[0], range[1], key);
+
+      // Verify
+      REQUIRE(decrypted == cleartext.substr(std::min(range[0], cleartext.size()), range[1]));
+    }
+  }
+
+  SECTION("With index") {
+    REQUIRE(GWrapper::IndexFile(filename_encrypted, key, 4));
+
+    for (const auto& range : ranges) {
+      // Exercise
+      const std::string decrypted = GWrapper::DecryptRange(filename_encrypted, range[0], range[1], key);
+
+      // Verify
+      REQUIRE(decrypted == cleartext.substr(std::min(range[0], cleartext.size()), range[1]));
+    }
+  }
+}
@@ -0,0 +1,189 @@
+#include <GCrypt/ChunkedCipher.h>
+#include <GCrypt/Key.h>
+#include "Catch2.h"
+#include <fstream>
+#include <sstream>
+#include <random>
+
+using namespace Leonetienne::GCrypt;
+
+namespace {
+  std::string RandomBytes(const std::size_t n) {
+    std::mt19937 rng(n);
+    std::string bytes(n, '\0');
+    for (char& c : bytes) {
+      c = (char)(rng() & 0xFF);
+    }
+
+    return bytes;
+  }
+
+  std::string ReadFile(const std::string& path) {
+    std::ifstream ifs(path, std::ios::binary);
+    std::stringstream ss;
+    ss << ifs.rdbuf();
+    return ss.str();
+  }
+}
+
+// Tests that decrypting a container yields the exact cleartext, for all kinds of lengths
+TEST_CASE(__FILE__"/encrypt-decrypt", "[Chunked cipher]") {
+
+  const Key key = Key::Random();
+  constexpr std::size_t chunkSize = 4 * Block::BLOCK_SIZE;
+
+  for (const std::size_t length : { 0, 1, 63, 64, 65, 256, 257, 3 * 256 + 5 }) {
+    // Setup
+    const std::string cleartext = RandomBytes(length);
+
+    // Exercise
+    const std::string container = ChunkedCipher::Encrypt(cleartext, key, chunkSize, 3);
+    const std::string decrypted = ChunkedCipher::Decrypt(container, key, 2);
+
+    // Verify
+    REQUIRE(decrypted == cleartext);
+  }
+}
+
+// Tests that the container does not depend on how many threads enciphered it
+TEST_CASE(__FILE__"/deterministic", "[Chunked cipher]") {
+
+  // Setup
+  const Key key = Key::Random();
+  const std::string cleartext = RandomBytes(10000);
+
+  // Exercise
+  const std::string a = ChunkedCipher::Encrypt(cleartext, key, 1024, 1);
+  const std::string b = ChunkedCipher::Encrypt(cleartext, key, 1024, 7);
+
+  // Verify
+  REQUIRE(a == b);
+}
+
+// Tests that equal chunks encipher differently, since every chunk has its own key
+TEST_CASE(__FILE__"/chunks-differ", "[Chunked cipher]") {
+
+  // Setup
+  const Key key = Key::Random();
+  const std::string cleartext(4 * 1024, 'a');
+
+  // Exercise
+  const std::string container = ChunkedCipher::Encrypt(cleartext, key, 1024);
+
+  // Verify
+  const std::size_t payloadOffset = (1 + 4) * Block::BLOCK_SIZE;
+  REQUIRE(container.substr(payloadOffset, 1024) != container.substr(payloadOffset + 1024, 1024));
+  REQUIRE(ChunkedCipher::DeriveChunkKey(key, 0) != ChunkedCipher::DeriveChunkKey(key, 1));
+}
+
+// Tests that malformed containers get rejected
+TEST_CASE(__FILE__"/malformed", "[Chunked cipher]") {
+
+  // Setup
+  const Key key = Key::Random();
+  const std::string container = ChunkedCipher::Encrypt(RandomBytes(1000), key, 256);
+
+  // Exercise and verify
+  REQUIRE_THROWS(ChunkedCipher::Decrypt("", key));
+  REQUIRE_THROWS(ChunkedCipher::Decrypt(container.substr(0, container.length() - 1), key));
+  REQUIRE_THROWS(ChunkedCipher::Decrypt(std::string(container.length(), '\0'), key));
+  REQUIRE_THROWS(ChunkedCipher::Encrypt("abc", key, 100));
+}
+
+// Tests that headers with sizes that wrap around while computing the layout get rejected.
+// Each of them would otherwise describe a container of just its header.
+TEST_CASE(__FILE__"/malformed-sizes", "[Chunked cipher]") {
+
+  // Setup
+  const Key key = Key::Random();
+
+  Block header;
+  header.Reset();
+  header[0] = 0x4B434347;
+  header[1] = 1;
+  header[2] = 64;
+
+  // Exercise and verify
+  // A cleartext length that wraps the chunk count to 0
+  header[4] = 0xFFFFFFF5;
+  header[5] = 0xFFFFFFFF;
+  REQUIRE_THROWS_AS(ChunkedCipher::Decrypt(std::string((const char*)(const void*)header.Data(), Block::BLOCK_SIZE), key), std::runtime_error);
+
+  // A chunk count that wraps the container size to one block
+  header[4] = 0;
+  header[5] = 0x80000000;
+  header[6] = 0;
+  header[7] = 0x02000000;
+  REQUIRE_THROWS_AS(ChunkedCipher::Decrypt(std::string((const char*)(const void*)header.Data(), Block::BLOCK_SIZE), key), std::runtime_error);
+}
+
+// Tests that encrypting and decrypting files yields the exact file back
+TEST_CASE(__FILE__"/files", "[Chunked cipher]") {
+
+  // Setup
+  const std::string filename_plain = "testAssets/testfile.png";
+  const std::string filename_encrypted = "testAssets/testfile.png.chunked.crypt";
+  const std::string filename_decrypted = "testAssets/testfile.png.chunked.clear.png";
+  const Key key = Key::FromPassword("Der Affe will Zucker");
+
+  // Exercise
+  REQUIRE(ChunkedCipher::EncryptFile(filename_plain, filename_encrypted, key, 4096));
+  REQUIRE(ChunkedCipher::DecryptFile(filename_encrypted, filename_decrypted, key));
+
+  // Verify
+  REQUIRE(ReadFile(filename_decrypted) == ReadFile(filename_plain));
+}
+
+// Tests that updating a container rewrites only the chunks that changed, and yields what encrypting from scratch yields
+TEST_CASE(__FILE__"/update", "[Chunked cipher]") {
+
+  // Setup
+  const std::string filename_plain = "testAssets/chunked-update.bin";
+  const std::string filename_container = "testAssets/chunked-update.bin.chunked";
+  const Key key = Key::FromPassword("Der Affe will Zucker");
+  constexpr std::size_t chunkSize = 1024;
+
+  const auto writePlain = [&filename_plain](const std::string& bytes) {
+    std::ofstream ofs(filename_plain, std::ios::binary | std::ios::trunc);
+    ofs.write(bytes.data(), bytes.length());
+  };
+
+  std::remove(filename_container.c_str());
+  std::remove(ChunkedCipher::FingerprintPath(filename_container).c_str());
+
+  std::string cleartext = RandomBytes(10 * chunkSize + 100);
+  std::size_t nChunksRewritten = 0;
+
+  // Exercise and verify: a new container gets written whole
+  writePlain(cleartext);
+  REQUIRE(ChunkedCipher::UpdateFile(filename_plain, filename_container, key, chunkSize, 2, &nChunksRewritten));
+  REQUIRE(nChunksRewritten == 11);
+  REQUIRE(ReadFile(filename_container) == ChunkedCipher::Encrypt(cleartext, key, chunkSize));
+
+  // Nothing changed
+  REQUIRE(ChunkedCipher::UpdateFile(filename_plain, filename_container, key, chunkSize, 2, &nChunksRewritten));
+  REQUIRE(nChunksRewritten == 0);
+
+  // Two chunks changed
+  cleartext[3 * chunkSize + 5] ^= 1;
+  cleartext[7 * chunkSize] ^= 1;
+  writePlain(cleartext);
+  REQUIRE(ChunkedCipher::UpdateFile(filename_plain, filename_container, key, chunkSize, 2, &nChunksRewritten));
+  REQUIRE(nChunksRewritten == 2);
+  REQUIRE(ReadFile(filename_container) == ChunkedCipher::Encrypt(cleartext, key, chunkSize));
+
+  // The last chunk shrunk
+  cleartext.resize(10 * chunkSize + 10);
+  writePlain(cleartext);
+  REQUIRE(ChunkedCipher::UpdateFile(filename_plain, filename_container, key, chunkSize, 2, &nChunksRewritten));
+  REQUIRE(nChunksRewritten == 1);
+  REQUIRE(ReadFile(filename_container) == ChunkedCipher::Encrypt(cleartext, key, chunkSize));
+
+  // The number of chunks changed
+  cleartext += RandomBytes(2 * chunkSize);
+  writePlain(cleartext);
+  REQUIRE(ChunkedCipher::UpdateFile(filename_plain, filename_container, key, chunkSize, 2, &nChunksRewritten));
+  REQUIRE(nChunksRewritten == 13);
+  REQUIRE(ChunkedCipher::DecryptFile(filename_container, filename_plain + ".clear", key));
+  REQUIRE(ReadFile(filename_plain + ".clear") == cleartext);
+}
@@ -85,3 +85,30 @@ TEST_CASE(__FILE__"MultiBlock_NoPadding/", "[Encryption/Decryption consistency]"
   );
 }
 
+
+// Tests that the bare feistel network deciphers what it enciphered, block after block
+TEST_CASE(__FILE__"/Feistel", "[Encryption/Decryption consistency]") {
+
+  // Setup
+  const Key key = Key::FromPassword("1234");
+  std::vector<Block> cleartext_blocks;
+  for (std::size_t i = 0; i < 16; i++) {
+    cleartext_blocks.emplace_back(Key::Random());
+  }
+
+  // Exercise
+  // (the round keys roll after every block, so use one instance per direction)
+  Feistel encipherer(key);
+  Feistel decipherer(key);
+
+  std::vector<Block> deciphered_blocks;
+  for (const Block& clearBlock : cleartext_blocks) {
+    deciphered_blocks.emplace_back(decipherer.Decipher(encipherer.Encipher(clearBlock)));
+  }
+
+  // Verify
+  REQUIRE(
+    cleartext_blocks ==
+    deciphered_blocks
+  );
+}
@@ -0,0 +1,147 @@
+#include <GCrypt/FeistelKernels.h>
+#include <GCrypt/Block.h>
+#include <GCrypt/Key.h>
+#include <GCrypt/SBoxLookup.h>
+#include "Catch2.h"
+
+using namespace Leonetienne::GCrypt;
+
+namespace {
+  // The feistel function, as it used to be implemented, chained from block operations
+  Block ChainedExpansion(const Halfblock& hb) {
+    Block b;
+    for (std::size_t i = 0; i < 16; i++) {
+      b[i] = hb[i];
+    }
+
+    for (std::size_t i = 0; i < 3; i++) {
+      b *= b.ShiftBitsRight();
+    }
+
+    return b;
+  }
+
+  Halfblock ChainedReduction(const Block& block) {
+    Halfblock hb;
+    for (std::size_t i = 0; i < 16; i++) {
+      hb[i] = block[i] % (1 << (Halfblock::CHUNK_SIZE_BITS - 1));
+    }
+
+    return hb;
+  }
+
+  void ChainedSBox(Block& block) {
+    std::uint8_t* bytes = (std::uint8_t*)(void*)block.Data();
+    for (std::size_t i = 1; i < Block::BLOCK_SIZE; i++) {
+      bytes[i] = sboxLookup[bytes[i]];
+    }
+
+    return;
+  }
+
+  Halfblock ChainedF(const Halfblock& m, const Key& key) {
+    Block m_expanded = ChainedExpansion(m);
+    m_expanded.ShiftCellsRightInplace();
+    m_expanded.ShiftRowsUpInplace();
+    m_expanded *= key;
+    m_expanded.ShiftBitsLeftInplace();
+    ChainedSBox(m_expanded);
+
+    Halfblock hb = ChainedReduction(m_expanded);
+    hb *= m;
+
+    return hb;
+  }
+
+  Halfblock RandomHalfblock() {
+    const Block b = Key::Random();
+
+    Halfblock hb;
+    for (std::size_t i = 0; i < 16; i++) {
+      hb[i] = b[i];
+    }
+
+    return hb;
+  }
+}
+
+// Tests that the expansion kernel yields the same as the chained block operations
+TEST_CASE(__FILE__"/expansion", "[Feistel kernels]") {
+
+  for (std::size_t run = 0; run < 100; run++) {
+    // Setup
+    const Halfblock hb = RandomHalfblock();
+
+    // Exercise
+    Block b;
+    Kernels::Expand(b.Data(), hb.Data());
+
+    // Verify
+    REQUIRE(b == ChainedExpansion(hb));
+  }
+}
+
+// Tests that the reduction kernel yields the same as the chained block operations
+TEST_CASE(__FILE__"/reduction", "[Feistel kernels]") {
+
+  for (std::size_t run = 0; run < 100; run++) {
+    // Setup
+    const Block b = Key::Random();
+
+    // Exercise
+    Halfblock hb;
+    Kernels::Reduce(hb.Data(), b.Data());
+
+    // Verify
+    REQUIRE(hb == ChainedReduction(b));
+  }
+}
+
+// Tests that the sbox kernel yields the same as the byte-wise lookup
+TEST_CASE(__FILE__"/sbox", "[Feistel kernels]") {
+
+  for (std::size_t run = 0; run < 100; run++) {
+    // Setup
+    Block a = Key::Random();
+    Block b = a;
+
+    // Exercise
+    Kernels::SBox((std::uint8_t*)(void*)a.Data());
+    ChainedSBox(b);
+
+    // Verify
+    REQUIRE(a == b);
+  }
+}
+
+// Tests that the fused feistel function yields the same as the chained block operations
+TEST_CASE(__FILE__"/fused-f", "[Feistel kernels]") {
+
+  for (std::size_t run = 0; run < 100; run++) {
+    // Setup
+    const Halfblock m = RandomHalfblock();
+    const Key key = Key::Random();
+
+    // Exercise
+    Halfblock hb;
+    Kernels::F(hb.Data(), m.Data(), key.Data());
+
+    // Verify
+    REQUIRE(hb == ChainedF(m, key));
+  }
+}
+
+// Tests that the fused feistel function may write to its own input
+TEST_CASE(__FILE__"/fused-f-inplace", "[Feistel kernels]") {
+
+  // Setup
+  Halfblock m = RandomHalfblock();
+  const Key key = Key::Random();
+  const Halfblock expected = ChainedF(m, key);
+
+  // Exercise
+  Kernels::F(m.Data(), m.Data(), key.Data());
+
+  // Verify
+  REQUIRE(m == expected);
+}
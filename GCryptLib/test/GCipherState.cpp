@@ -0,0 +1,130 @@
+#include <GCrypt/GCipher.h>
+#include <GCrypt/GCipherState.h>
+#include <GCrypt/GWrapper.h>
+#include <GCrypt/Util.h>
+#include "Catch2.h"
+#include "TestUtil.h"
+#include <cstdio>
+#include <fstream>
+
+using namespace Leonetienne::GCrypt;
+
+// Tests that a restored cipher continues the stream exactly where the snapshot was taken
+TEST_CASE(__FILE__"/resume", "[GCipher state]") {
+
+  for (const GCipher::DIRECTION direction : { GCipher::DIRECTION::ENCIPHER, GCipher::DIRECTION::DECIPHER }) {
+    for (const GCipher::KEY_SCHEDULE keySchedule : { GCipher::KEY_SCHEDULE::INLINE, GCipher::KEY_SCHEDULE::LOOKAHEAD }) {
+      // Setup
+      const Key key = Key::Random();
+      const std::vector<Block> input = RandomBlocks(40);
+
+      GCipher reference(key, direction);
+      const std::vector<Block> expected = DigestAll(reference, input);
+
+      // Exercise
+      GCipher cipher(key, direction, keySchedule);
+      std::vector<Block> digested;
+      for (std::size_t i = 0; i < 25; i++) {
+        digested.emplace_back(cipher.Digest(input[i]));
+      }
+
+      // Take the snapshot through its bytes, as if it had been stored away
+      const GCipherState state(cipher.SaveState().GetBytes());
+
+      GCipher resumed;
+      resumed.RestoreState(state, keySchedule);
+      for (std::size_t i = 25; i < input.size(); i++) {
+        digested.emplace_back(resumed.Digest(input[i]));
+      }
+
+      // Verify
+      REQUIRE(digested == expected);
+    }
+  }
+}
+
+// Tests that a snapshot of a fresh cipher continues from the very first block
+TEST_CASE(__FILE__"/fresh", "[GCipher state]") {
+
+  // Setup
+  const Key key = Key::Random();
+  const std::vector<Block> input = RandomBlocks(5);
+
+  GCipher reference(key, GCipher::DIRECTION::ENCIPHER);
+  const std::vector<Block> expected = DigestAll(reference, input);
+
+  // Exercise
+  GCipher cipher;
+  cipher.RestoreState(GCipher(key, GCipher::DIRECTION::ENCIPHER).SaveState());
+
+  // Verify
+  REQUIRE(DigestAll(cipher, input) == expected);
+}
+
+// Tests that malformed snapshots get rejected
+TEST_CASE(__FILE__"/malformed", "[GCipher state]") {
+
+  // Setup
+  const std::string bytes = GCipher(Key::Random(), GCipher::DIRECTION::ENCIPHER).SaveState().GetBytes();
+  std::string wrongMagic = bytes;
+  wrongMagic[0] ^= 1;
+
+  // Direction sits in the third cell of the header block
+  std::string wrongDirection = bytes;
+  wrongDirection[2 * sizeof(std::uint32_t)] = 7;
+
+  const std::string filename_wrongDirection = "testAssets/state.wrongdirection";
+  {
+    std::ofstream ofs(filename_wrongDirection, std::ios::binary);
+    ofs.write(wrongDirection.data(), wrongDirection.size());
+  }
+
+  GCipher cipher;
+
+  // Exercise and verify
+  REQUIRE(bytes.size() == (2 + N_ROUNDS) * Block::BLOCK_SIZE);
+  REQUIRE_THROWS(GCipherState(""));
+  REQUIRE_THROWS(GCipherState(wrongMagic));
+  REQUIRE_THROWS(GCipherState(bytes.substr(0, bytes.size() - 1)));
+  REQUIRE_THROWS(GCipherState(wrongDirection));
+  REQUIRE_THROWS(GCipherState::LoadFromFile(filename_wrongDirection));
+  REQUIRE_THROWS(cipher.RestoreState(GCipherState()));
+  REQUIRE_THROWS(GCipher().SaveState());
+
+  // Cleanup
+  std::remove(filename_wrongDirection.c_str());
+}
+
+// Tests that appending to an encrypted file yields what encrypting everything at once yields
+TEST_CASE(__FILE__"/append", "[GCipher state]") {
+
+  // Setup
+  const Key key = Key::FromPassword("Der Affe will Zucker");
+  const std::string filename_first = "testAssets/testfile.png";
+  const std::string filename_second = "testAssets/testfile.png.append.second";
+  const std::string filename_log = "testAssets/testfile.png.append.crypt";
+  const std::string filename_state = "testAssets/testfile.png.append.state";
+
+  const std::vector<Block> first = ReadFileToBlocks(filename_first);
+  const std::vector<Block> second = RandomBlocks(30);
+  WriteBlocksToFile(filename_second, second);
+
+  std::vector<Block> everything = first;
+  everything.insert(everything.end(), second.begin(), second.end());
+  const std::vector<Block> expected = GWrapper::CipherBlocks(everything, key, GCipher::DIRECTION::ENCIPHER);
+
+  // Exercise: append both, keeping the state in a file in between
+  std::remove(filename_log.c_str());
+  GCipherState state = GCipher(key, GCipher::DIRECTION::ENCIPHER).SaveState();
+  REQUIRE(GWrapper::AppendToEncryptedFile(filename_first, filename_log, state));
+  state.WriteToFile(filename_state);
+
+  GCipherState loadedState = GCipherState::LoadFromFile(filename_state);
+  REQUIRE(GWrapper::AppendToEncryptedFile(filename_second, filename_log, loadedState));
+
+  // Verify
+  REQUIRE(ReadFileToBlocks(filename_log) == expected);
+
+  // Reconstructing the state from the file yields the same state
+  REQUIRE(GWrapper::StateAtEndOfFile(filename_log, key).GetBytes() == loadedState.GetBytes());
+}
@@ -0,0 +1,190 @@
+#include <GCrypt/GCounterCipher.h>
+#include <GCrypt/GCipher.h>
+#include <GCrypt/GWrapper.h>
+#include <GCrypt/InitializationVector.h>
+#include <GCrypt/Util.h>
+#include "Catch2.h"
+#include "TestUtil.h"
+#include <fstream>
+#include <sstream>
+
+using namespace Leonetienne::GCrypt;
+
+// Tests that digesting ciphertext in counter mode yields the cleartext
+TEST_CASE(__FILE__"/encrypt-decrypt", "[Counter mode]") {
+
+  // Setup
+  const Key key = Key::Random();
+  const Block nonce = Key::Random();
+  const std::vector<Block> cleartext = RandomBlocks(300);
+
+  // Exercise
+  std::vector<Block> ciphertext;
+  GCounterCipher encipher(key, nonce);
+  for (const Block& block : cleartext) {
+    ciphertext.emplace_back(encipher.Digest(block));
+  }
+
+  std::vector<Block> decrypted;
+  GCounterCipher decipher(key, nonce);
+  for (const Block& block : ciphertext) {
+    decrypted.emplace_back(decipher.Digest(block));
+  }
+
+  // Verify
+  REQUIRE(ciphertext != cleartext);
+  REQUIRE(decrypted == cleartext);
+}
+
+// Tests that counter mode does not just reproduce CBC
+TEST_CASE(__FILE__"/differs-from-cbc", "[Counter mode]") {
+
+  // Setup
+  const Key key = Key::Random();
+  Block zero;
+  zero.Reset();
+
+  // Exercise
+  // Even with the nonce being the initialization vector CBC starts from
+  GCounterCipher counterCipher(key, InitializationVector(key));
+  GCipher cbcCipher(key, GCipher::DIRECTION::ENCIPHER);
+
+  // Verify
+  REQUIRE(counterCipher.Digest(zero) != cbcCipher.Digest(zero));
+}
+
+// Tests that digesting on multiple threads yields exactly what digesting block by block yields
+TEST_CASE(__FILE__"/parallel-equals-sequential", "[Counter mode]") {
+
+  // Setup
+  const Key key = Key::Random();
+  const Block nonce = Key::Random();
+  const std::vector<Block> cleartext = RandomBlocks(1000);
+
+  std::vector<Block> expected;
+  GCounterCipher sequential(key, nonce);
+  for (const Block& block : cleartext) {
+    expected.emplace_back(sequential.Digest(block));
+  }
+
+  for (const std::size_t nThreads : { 1, 2, 3, 8 }) {
+    // Exercise
+    std::vector<Block> blocks = cleartext;
+    GCounterCipher parallel(key, nonce);
+    parallel.DigestInplace(blocks, nThreads);
+
+    // Verify
+    REQUIRE(blocks == expected);
+    REQUIRE(parallel.GetPosition() == cleartext.size());
+  }
+}
+
+// Tests that seeking to a block digests it just like getting there block by block does
+TEST_CASE(__FILE__"/seek", "[Counter mode]") {
+
+  // Setup
+  const Key key = Key::Random();
+  const Block nonce = Key::Random();
+  const std::vector<Block> cleartext = RandomBlocks(100);
+
+  std::vector<Block> expected;
+  GCounterCipher sequential(key, nonce);
+  for (const Block& block : cleartext) {
+    expected.emplace_back(sequential.Digest(block));
+  }
+
+  // Exercise
+  GCounterCipher cipher(key, nonce);
+  cipher.Seek(73);
+  const Block digested = cipher.Digest(cleartext[73]);
+
+  // Verify
+  REQUIRE(digested == expected[73]);
+  REQUIRE(cipher.GetPosition() == 74);
+}
+
+// Tests that different nonces yield different keystreams
+TEST_CASE(__FILE__"/nonce", "[Counter mode]") {
+
+  // Setup
+  const Key key = Key::Random();
+  const Block cleartext = Key::Random();
+
+  // Exercise
+  GCounterCipher a(key, Key::Random());
+  GCounterCipher b(key, Key::Random());
+
+  // Verify
+  REQUIRE(a.Digest(cleartext) != b.Digest(cleartext));
+}
+
+// Tests that an uninitialized cipher refuses to digest
+TEST_CASE(__FILE__"/uninitialized", "[Counter mode]") {
+
+  // Setup
+  GCounterCipher cipher;
+
+  // Exercise and verify
+  REQUIRE_THROWS(cipher.Digest(Block()));
+}
+
+// Tests that the wrapper encrypts and decrypts strings and files in counter mode, and decrypts ranges of them
+TEST_CASE(__FILE__"/wrapper", "[Counter mode]") {
+
+  // Setup
+  const Key key = Key::FromPassword("Der Affe will Zucker");
+  const std::string plaintext = "Hello, World! This string spans more than a single block of sixty-four bytes.";
+
+  const std::string filename_plain = "testAssets/testfile.png";
+  const std::string filename_encrypted = "testAssets/testfile.png.counter.crypt";
+  const std::string filename_decrypted = "testAssets/testfile.png.counter.clear.png";
+
+  // Exercise
+  const std::string ciphertext = GWrapper::EncryptString(plaintext, key, GWrapper::MODE::COUNTER);
+  const std::string decrypted = GWrapper::DecryptString(ciphertext, key, GWrapper::MODE::COUNTER);
+
+  REQUIRE(GWrapper::EncryptFile(filename_plain, filename_encrypted, key, false, GWrapper::MODE::COUNTER));
+  REQUIRE(GWrapper::DecryptFile(filename_encrypted, filename_decrypted, key, false, GWrapper::MODE::COUNTER));
+
+  // Verify
+  REQUIRE(decrypted == plaintext);
+  REQUIRE(ciphertext != GWrapper::EncryptString(plaintext, key));
+
+  const std::string expected = BitblocksToBytes(ReadFileToBlocks(filename_plain));
+  REQUIRE(BitblocksToBytes(ReadFileToBlocks(filename_decrypted)) == expected);
+  REQUIRE(GWrapper::DecryptRange(filename_encrypted, 1000, 300, key, GWrapper::MODE::COUNTER) == expected.substr(1000, 300));
+  REQUIRE(GWrapper::DecryptRange(filename_encrypted, 0, 10, key, GWrapper::MODE::COUNTER) == expected.substr(0, 10));
+  REQUIRE(GWrapper::DecryptRange(filename_encrypted, 1000, std::string::npos, key, GWrapper::MODE::COUNTER) == expected.substr(1000));
+}
+
+// Tests that the wrapper uses a fresh nonce for every encryption, so equal cleartexts under the same key encrypt differently
+TEST_CASE(__FILE__"/wrapper-fresh-nonce", "[Counter mode]") {
+
+  // Setup
+  const Key key = Key::Random();
+  const std::string plaintext = "Hello, World! This string spans more than a single block of sixty-four bytes.";
+
+  const std::string filename_plain = "testAssets/testfile.png";
+  const std::string filename_encrypted_a = "testAssets/testfile.png.counter.a.crypt";
+  const std::string filename_encrypted_b = "testAssets/testfile.png.counter.b.crypt";
+
+  // Exercise
+  const std::string ciphertextA = GWrapper::EncryptString(plaintext, key, GWrapper::MODE::COUNTER);
+  const std::string ciphertextB = GWrapper::EncryptString(plaintext, key, GWrapper::MODE::COUNTER);
+
+  REQUIRE(GWrapper::EncryptFile(filename_plain, filename_encrypted_a, key, false, GWrapper::MODE::COUNTER));
+  REQUIRE(GWrapper::EncryptFile(filename_plain, filename_encrypted_b, key, false, GWrapper::MODE::COUNTER));
+
+  // Verify
+  REQUIRE(ciphertextA != ciphertextB);
+  REQUIRE(GWrapper::DecryptString(ciphertextA, key, GWrapper::MODE::COUNTER) == plaintext);
+  REQUIRE(GWrapper::DecryptString(ciphertextB, key, GWrapper::MODE::COUNTER) == plaintext);
+
+  // Beyond the nonce, not a single block may repeat
+  const std::vector<Block> blocksA = ReadFileToBlocks(filename_encrypted_a);
+  const std::vector<Block> blocksB = ReadFileToBlocks(filename_encrypted_b);
+  REQUIRE(blocksA.size() == blocksB.size());
+  for (std::size_t i = 0; i < blocksA.size(); i++) {
+    REQUIRE(blocksA[i] != blocksB[i]);
+  }
+}
@@ -0,0 +1,134 @@
+#include <GCrypt/GHash.h>
+#include <GCrypt/Util.h>
+#include "Catch2.h"
+#include "TestUtil.h"
+#include <sstream>
+
+using namespace Leonetienne::GCrypt;
+
+// Tests that streaming a string yields what hashing it whole yields, no matter how the bytes get split up
+TEST_CASE(__FILE__"/update-equals-calculate-hashsum", "[GHash]") {
+
+  // Setup
+  const std::string input = RandomBytes(1000);
+
+  // Go through lengths that hit, and miss, block boundaries
+  for (const std::size_t n : { 0, 1, 63, 64, 65, 128, 500, 1000 }) {
+    const std::string bytes = input.substr(0, n);
+    const Block expected = GHash::CalculateHashsum(StringToBitblocks(bytes), n);
+
+    for (const std::size_t pieceSize : { 1, 7, 64, 100, 2000 }) {
+
+      // Exercise
+      GHash hasher;
+      for (std::size_t i = 0; i < n; i += pieceSize) {
+        hasher.Update(bytes.substr(i, pieceSize));
+      }
+      const Block hashsum = hasher.Finalize();
+
+      // Verify
+      REQUIRE(hashsum == expected);
+    }
+  }
+}
+
+// Tests that streaming distinguishes inputs that only differ in trailing nullbytes
+TEST_CASE(__FILE__"/length-matters", "[GHash]") {
+
+  // Setup
+  GHash a;
+  GHash b;
+
+  // Exercise
+  a.Update(std::string("\x29\x3e\xff", 3));
+  b.Update(std::string("\x29\x3e\xff\x00\x00", 5));
+
+  // Verify
+  REQUIRE(a.Finalize() != b.Finalize());
+}
+
+// Tests that a finalized hasher refuses any more input
+TEST_CASE(__FILE__"/no-update-after-finalize", "[GHash]") {
+
+  // Setup
+  GHash hasher;
+  hasher.Update("Hello");
+
+  // Exercise
+  const Block hashsum = hasher.Finalize();
+
+  // Verify
+  REQUIRE(hashsum == GHash::HashString("Hello"));
+  REQUIRE_THROWS(hasher.Update("World"));
+  REQUIRE_THROWS(hasher.Finalize());
+}
+
+// Tests that hashing a file yields what hashing all of its blocks yields
+TEST_CASE(__FILE__"/hash-file", "[GHash]") {
+
+  // Setup
+  const std::string filename = "testAssets/testfile.png";
+  std::size_t n_bytes;
+  const std::vector<Block> blocks = ReadFileToBlocks(filename, n_bytes);
+
+  // Exercise
+  const Block hashsum = GHash::HashFile(filename);
+
+  // Verify
+  REQUIRE(hashsum == GHash::CalculateHashsum(blocks, n_bytes));
+  REQUIRE_THROWS(GHash::HashFile("testAssets/does-not-exist"));
+}
+
+// Tests that digesting blocks in bulk yields the same hashsum as digesting them one by one
+TEST_CASE(__FILE__"/bulk-digest-equals-digest", "[GHash]") {
+
+  // Setup
+  std::vector<Block> blocks(100);
+  for (Block& block : blocks) {
+    block = Key::Random();
+  }
+
+  for (const std::size_t n : { 0, 1, 2, 3, 100 }) {
+    GHash expected;
+    for (std::size_t i = 0; i < n; i++) {
+      expected.Digest(blocks[i]);
+    }
+
+    // Exercise
+    GHash hasher;
+    hasher.Digest(blocks.data(), n);
+
+    // Verify
+    REQUIRE(hasher.GetHashsum() == expected.GetHashsum());
+  }
+}
+
+// Tests that an assigned hasher continues, and finalizes, exactly where the original was
+TEST_CASE(__FILE__"/assignment", "[GHash]") {
+
+  // Setup
+  const std::string input = RandomBytes(1000);
+
+  GHash original;
+  original.Update(input.substr(0, 600));
+
+  // Exercise
+  GHash copy;
+  copy.Update("Something else entirely");
+  copy = original;
+
+  original.Update(input.substr(600));
+  copy.Update(input.substr(600));
+
+  const Block expected = original.Finalize();
+  const Block hashsum = copy.Finalize();
+
+  GHash finalizedCopy;
+  finalizedCopy = copy;
+
+  // Verify
+  REQUIRE(hashsum == expected);
+  REQUIRE(hashsum == GHash::HashString(input));
+  REQUIRE(finalizedCopy.GetHashsum() == expected);
+  REQUIRE_THROWS(finalizedCopy.Update("more"));
+}
@@ -0,0 +1,85 @@
+#include <GCrypt/GTreeHash.h>
+#include <GCrypt/GHash.h>
+#include <GCrypt/Key.h>
+#include "Catch2.h"
+#include "TestUtil.h"
+#include <fstream>
+#include <sstream>
+
+using namespace Leonetienne::GCrypt;
+
+// Tests that the hashsum does not depend on how many threads hash the leaves
+TEST_CASE(__FILE__"/thread-count-independent", "[GTreeHash]") {
+
+  // Setup
+  // Five whole leaves, and a short one
+  const std::string input = RandomBytes(5 * GTreeHash::LEAF_SIZE + 100);
+  const Block expected = GTreeHash::CalculateHashsum(input, 1);
+
+  for (const std::size_t nThreads : { 2, 3, 8 }) {
+
+    // Exercise
+    const Block hashsum = GTreeHash::CalculateHashsum(input, nThreads);
+
+    // Verify
+    REQUIRE(hashsum == expected);
+  }
+}
+
+// Tests that the hashsum does not depend on how the bytes get fed
+TEST_CASE(__FILE__"/update-equals-calculate-hashsum", "[GTreeHash]") {
+
+  // Setup
+  const std::string input = RandomBytes(3 * GTreeHash::LEAF_SIZE);
+  const Block expected = GTreeHash::CalculateHashsum(input, 2);
+
+  // Exercise
+  GTreeHash hasher(2);
+  for (std::size_t i = 0; i < input.length(); i += 100000) {
+    hasher.Update(input.substr(i, 100000));
+  }
+  const Block hashsum = hasher.Finalize();
+
+  // Verify
+  REQUIRE(hashsum == expected);
+  REQUIRE_THROWS(hasher.Update("more"));
+  REQUIRE_THROWS(hasher.Finalize());
+}
+
+// Tests that the tree hash is its own hash function, and still tells inputs apart by content, length and order
+TEST_CASE(__FILE__"/distinct-hashsums", "[GTreeHash]") {
+
+  // Setup
+  const std::string leafA = RandomBytes(GTreeHash::LEAF_SIZE);
+  const std::string leafB = RandomBytes(GTreeHash::LEAF_SIZE);
+
+  // Exercise
+  const Block empty = GTreeHash::CalculateHashsum("");
+  const Block ab = GTreeHash::CalculateHashsum(leafA + leafB);
+  const Block ba = GTreeHash::CalculateHashsum(leafB + leafA);
+  const Block aa = GTreeHash::CalculateHashsum(leafA + leafA);
+  const Block abPadded = GTreeHash::CalculateHashsum(leafA + leafB + std::string(1, '\0'));
+
+  // Verify
+  REQUIRE(empty != GHash::HashString(""));
+  REQUIRE(ab != GHash::HashString(leafA + leafB));
+  REQUIRE(ab != ba);
+  REQUIRE(ab != aa);
+  REQUIRE(ab != abPadded);
+}
+
+// Tests that hashing a file yields what hashing its bytes yields
+TEST_CASE(__FILE__"/hash-file", "[GTreeHash]") {
+
+  // Setup
+  const std::string filename = "testAssets/testfile.png";
+  std::stringstream ss;
+  ss << std::ifstream(filename, std::ios::binary).rdbuf();
+
+  // Exercise
+  const Block hashsum = GTreeHash::HashFile(filename);
+
+  // Verify
+  REQUIRE(hashsum == GTreeHash::CalculateHashsum(ss.str()));
+  REQUIRE_THROWS(GTreeHash::HashFile("testAssets/does-not-exist"));
+}
@@ -0,0 +1,141 @@
+#include <GCrypt/HashingCipher.h>
+#include <GCrypt/GWrapper.h>
+#include <GCrypt/Util.h>
+#include "Catch2.h"
+#include "TestUtil.h"
+#include <chrono>
+#include <fstream>
+#include <thread>
+
+using namespace Leonetienne::GCrypt;
+
+// Tests that enciphering yields what GCipher yields, and hashes what hashing the ciphertext afterwards would
+TEST_CASE(__FILE__"/encipher-equals-two-passes", "[Hashing cipher]") {
+
+  // Setup
+  const Key key = Key::Random();
+  const std::vector<Block> cleartext = RandomBlocks(1000);
+
+  const std::vector<Block> expectedCiphertext = GWrapper::CipherBlocks(cleartext, key, GCipher::DIRECTION::ENCIPHER);
+  const Block expectedHashsum = GHash::CalculateHashsum(expectedCiphertext);
+
+  // Exercise
+  HashingCipher cipher(key, GCipher::DIRECTION::ENCIPHER);
+  std::vector<Block> ciphertext;
+  for (const Block& block : cleartext) {
+    ciphertext.emplace_back(cipher.Digest(block));
+  }
+  const Block hashsum = cipher.Finish();
+
+  // Verify
+  REQUIRE(ciphertext == expectedCiphertext);
+  REQUIRE(hashsum == expectedHashsum);
+}
+
+// Tests that deciphering yields the cleartext, and the same hashsum as enciphering
+TEST_CASE(__FILE__"/decipher-same-hashsum", "[Hashing cipher]") {
+
+  // Setup
+  const Key key = Key::Random();
+  const std::vector<Block> cleartext = RandomBlocks(300);
+
+  HashingCipher encipher(key, GCipher::DIRECTION::ENCIPHER);
+  std::vector<Block> ciphertext;
+  for (const Block& block : cleartext) {
+    ciphertext.emplace_back(encipher.Digest(block));
+  }
+  const Block expectedHashsum = encipher.Finish();
+
+  // Exercise
+  HashingCipher decipher(key, GCipher::DIRECTION::DECIPHER);
+  std::vector<Block> decrypted;
+  for (const Block& block : ciphertext) {
+    decrypted.emplace_back(decipher.Digest(block));
+  }
+  const Block hashsum = decipher.Finish();
+
+  // Verify
+  REQUIRE(decrypted == cleartext);
+  REQUIRE(hashsum == expectedHashsum);
+}
+
+// Tests that nothing can be digested after finishing, and that finishing early is fine
+TEST_CASE(__FILE__"/finish", "[Hashing cipher]") {
+
+  // Setup
+  const Key key = Key::Random();
+  HashingCipher cipher(key, GCipher::DIRECTION::ENCIPHER);
+
+  // Exercise
+  const Block hashsum = cipher.Finish();
+
+  // Verify
+  REQUIRE(hashsum == GHash::CalculateHashsum({}));
+  REQUIRE_THROWS(cipher.Digest(Block()));
+  REQUIRE_THROWS(cipher.Finish());
+
+  // A cipher that never gets finished must still shut down
+  HashingCipher abandoned(key, GCipher::DIRECTION::ENCIPHER);
+  abandoned.Digest(Block());
+}
+
+// Tests that the file wrapper round-trips, and refuses to decrypt a corrupted file
+TEST_CASE(__FILE__"/files", "[Hashing cipher]") {
+
+  // Setup
+  const std::string filename_plain = "testAssets/testfile.png";
+  const std::string filename_encrypted = "testAssets/testfile.png.hashed.crypt";
+  const std::string filename_decrypted = "testAssets/testfile.png.hashed.clear.png";
+  const std::string filename_corrupted_out = "testAssets/testfile.png.hashed.corrupted.png";
+  const Key key = Key::FromPassword("Der Affe will Zucker");
+
+  // Exercise
+  Block hashsum;
+  REQUIRE(GWrapper::EncryptAndDigestFile(filename_plain, filename_encrypted, key, hashsum));
+  REQUIRE(GWrapper::DecryptAndVerifyFile(filename_encrypted, filename_decrypted, key, hashsum));
+
+  // Verify
+  REQUIRE(hashsum == GHash::CalculateHashsum(ReadFileToBlocks(filename_encrypted)));
+  REQUIRE(ReadFileToBlocks(filename_decrypted) == ReadFileToBlocks(filename_plain));
+
+  // Flip a byte of the ciphertext
+  {
+    std::fstream fs(filename_encrypted, std::ios::binary | std::ios::in | std::ios::out);
+    fs.seekg(100);
+    const char c = (char)fs.get();
+    fs.seekp(100);
+    fs.put((char)(c ^ 1));
+  }
+
+  std::remove(filename_corrupted_out.c_str());
+  REQUIRE_FALSE(GWrapper::DecryptAndVerifyFile(filename_encrypted, filename_corrupted_out, key, hashsum));
+  REQUIRE_FALSE(std::ifstream(filename_corrupted_out).good());
+}
+
+// Tests that a hasher, blocked waiting for blocks, wakes up for more blocks, and to finish
+TEST_CASE(__FILE__"/blocked-hasher", "[Hashing cipher]") {
+
+  // Setup
+  const Key key = Key::Random();
+  const std::vector<Block> cleartext = RandomBlocks(2 * HashingCipher::QUEUE_CAPACITY);
+
+  const std::vector<Block> expectedCiphertext = GWrapper::CipherBlocks(cleartext, key, GCipher::DIRECTION::ENCIPHER);
+  const Block expectedHashsum = GHash::CalculateHashsum(expectedCiphertext);
+
+  // Exercise
+  // Give the hasher time to block, before every batch of blocks, and before finishing
+  HashingCipher cipher(key, GCipher::DIRECTION::ENCIPHER);
+  std::vector<Block> ciphertext;
+  for (std::size_t i = 0; i < cleartext.size(); i++) {
+    if (i % 100 == 0) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    ciphertext.emplace_back(cipher.Digest(cleartext[i]));
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  const Block hashsum = cipher.Finish();
+
+  // Verify
+  REQUIRE(ciphertext == expectedCiphertext);
+  REQUIRE(hashsum == expectedHashsum);
+}
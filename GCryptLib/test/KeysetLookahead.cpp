@@ -0,0 +1,163 @@
+#include <GCrypt/GCipher.h>
+#include <GCrypt/KeysetLookahead.h>
+#include <GCrypt/Key.h>
+#include "Catch2.h"
+#include "TestUtil.h"
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace Leonetienne::GCrypt;
+
+// Tests that the lookahead yields the same keysets as rolling them inline
+TEST_CASE(__FILE__"/same-keysets-as-inline", "[Keyset lookahead]") {
+
+  // Setup
+  const Key key = Key::Random();
+  Keyset expected;
+  Feistel::GenerateKeyset(expected, key);
+
+  // Exercise
+  KeysetLookahead lookahead(key);
+
+  // Verify
+  for (std::size_t i = 0; i < 3 * KeysetLookahead::CAPACITY; i++) {
+    const Keyset& keyset = lookahead.Peek();
+    REQUIRE(keyset.roundKeys == expected.roundKeys);
+    REQUIRE(keyset.reducedRoundKeys == expected.reducedRoundKeys);
+
+    lookahead.Pop();
+    Feistel::RollKeyset(expected);
+  }
+}
+
+// Tests that encrypting with a lookahead key schedule yields the same ciphertext as the inline one
+TEST_CASE(__FILE__"/encipher-same-as-inline", "[Keyset lookahead]") {
+
+  // Setup
+  const Key key = Key::Random();
+  const std::vector<Block> cleartext = RandomBlocks(100);
+
+  GCipher inlineCipher(key, GCipher::DIRECTION::ENCIPHER, GCipher::KEY_SCHEDULE::INLINE);
+  GCipher lookaheadCipher(key, GCipher::DIRECTION::ENCIPHER, GCipher::KEY_SCHEDULE::LOOKAHEAD);
+
+  // Exercise
+  const std::vector<Block> expected = DigestAll(inlineCipher, cleartext);
+  const std::vector<Block> ciphertext = DigestAll(lookaheadCipher, cleartext);
+
+  // Verify
+  REQUIRE(ciphertext == expected);
+}
+
+// Tests that decrypting with a lookahead key schedule yields the cleartext
+TEST_CASE(__FILE__"/decipher", "[Keyset lookahead]") {
+
+  // Setup
+  const Key key = Key::Random();
+  const std::vector<Block> cleartext = RandomBlocks(100);
+
+  GCipher encipherer(key, GCipher::DIRECTION::ENCIPHER, GCipher::KEY_SCHEDULE::LOOKAHEAD);
+  GCipher decipherer(key, GCipher::DIRECTION::DECIPHER, GCipher::KEY_SCHEDULE::LOOKAHEAD);
+
+  // Exercise
+  const std::vector<Block> deciphered = DigestAll(decipherer, DigestAll(encipherer, cleartext));
+
+  // Verify
+  REQUIRE(deciphered == cleartext);
+}
+
+// Tests that changing the key restarts the lookahead from that key
+TEST_CASE(__FILE__"/set-key", "[Keyset lookahead]") {
+
+  // Setup
+  const Key key = Key::Random();
+  const Key newKey = Key::Random();
+  const std::vector<Block> cleartext = RandomBlocks(10);
+
+  GCipher inlineCipher(key, GCipher::DIRECTION::ENCIPHER, GCipher::KEY_SCHEDULE::INLINE);
+  GCipher lookaheadCipher(key, GCipher::DIRECTION::ENCIPHER, GCipher::KEY_SCHEDULE::LOOKAHEAD);
+
+  // Exercise
+  DigestAll(inlineCipher, cleartext);
+  DigestAll(lookaheadCipher, cleartext);
+  inlineCipher.SetKey(newKey);
+  lookaheadCipher.SetKey(newKey);
+
+  // Verify
+  REQUIRE(DigestAll(lookaheadCipher, cleartext) == DigestAll(inlineCipher, cleartext));
+}
+
+// Tests that assigning a cipher continues from the keyset the other one would use next
+TEST_CASE(__FILE__"/assignment", "[Keyset lookahead]") {
+
+  // Setup
+  const Key key = Key::Random();
+  const std::vector<Block> cleartext = RandomBlocks(10);
+
+  GCipher inlineCipher(key, GCipher::DIRECTION::ENCIPHER, GCipher::KEY_SCHEDULE::INLINE);
+  GCipher lookaheadCipher(key, GCipher::DIRECTION::ENCIPHER, GCipher::KEY_SCHEDULE::LOOKAHEAD);
+  DigestAll(inlineCipher, cleartext);
+  DigestAll(lookaheadCipher, cleartext);
+
+  // Exercise
+  GCipher copy;
+  copy = lookaheadCipher;
+
+  // Verify
+  REQUIRE(DigestAll(copy, cleartext) == DigestAll(inlineCipher, cleartext));
+}
+
+// Tests that reseeding discards everything computed ahead, and continues from the new seed
+TEST_CASE(__FILE__"/reseed", "[Keyset lookahead]") {
+
+  // Setup
+  const Key key = Key::Random();
+  const Key newKey = Key::Random();
+  Keyset expected;
+  Feistel::GenerateKeyset(expected, newKey);
+
+  KeysetLookahead lookahead(key);
+  lookahead.Pop();
+  lookahead.Pop();
+
+  // Exercise
+  lookahead.Reseed(newKey);
+
+  // Verify
+  for (std::size_t i = 0; i < 3 * KeysetLookahead::CAPACITY; i++) {
+    REQUIRE(lookahead.Peek().roundKeys == expected.roundKeys);
+
+    lookahead.Pop();
+    Feistel::RollKeyset(expected);
+  }
+}
+
+// Tests that a producer, blocked on a full ring, wakes up to go on, to reseed, and to stop
+TEST_CASE(__FILE__"/blocked-producer", "[Keyset lookahead]") {
+
+  // Setup
+  const Key key = Key::Random();
+  Keyset expected;
+  Feistel::GenerateKeyset(expected, key);
+
+  KeysetLookahead lookahead(key);
+
+  // Exercise
+  // Give the producer time to fill the ring, and to block
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+  // Verify
+  for (std::size_t i = 0; i < 3 * KeysetLookahead::CAPACITY; i++) {
+    REQUIRE(lookahead.Peek().roundKeys == expected.roundKeys);
+
+    lookahead.Pop();
+    Feistel::RollKeyset(expected);
+  }
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  lookahead.Reseed(key);
+  Feistel::GenerateKeyset(expected, key);
+  REQUIRE(lookahead.Peek().roundKeys == expected.roundKeys);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+}
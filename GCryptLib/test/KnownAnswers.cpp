@@ -0,0 +1,54 @@
+#include <GCrypt/GWrapper.h>
+#include <GCrypt/GHash.h>
+#include <GCrypt/Util.h>
+#include "Catch2.h"
+
+using namespace Leonetienne::GCrypt;
+
+// These tests pin the outputs of the cipher and the hash function down.
+// The block operations have several (vectorized) implementations,
+// which must all produce the exact same results.
+// THESE TESTS ASSUME A LITTLE-ENDIAN PLATFORM
+
+// Tests that a password translates to a known key
+TEST_CASE(__FILE__"/Password to key", "[Known answers]") {
+
+  // Exercise
+  const Key key = Key::FromPassword("golden");
+
+  // Verify
+  REQUIRE(key.ToHexString() ==
+    "691c453cf00518418dd6d14f19da115b482fc482fc9a3c1a7a072c98d3d60d8d"
+    "07f57800958e77bd25ecd5ea8a03dbfb8ce2ac7942d0f203a5dd8ad5ebb61e2c"
+  );
+}
+
+// Tests that hashing the empty string yields a known hashsum
+TEST_CASE(__FILE__"/Hashing an empty string", "[Known answers]") {
+
+  // Exercise
+  const Block hashsum = GHash::HashString("");
+
+  // Verify
+  REQUIRE(hashsum.ToHexString() ==
+    "c9d6f3368829857a60df08fc1a04f27a2c92ca8adc97820699e7a5c2a4cfceae"
+    "2801a183c8521f95923c75c041d14b01cb4e4c33354da54f4c21af016bd7798d"
+  );
+}
+
+// Tests that encrypting a string yields a known ciphertext, and decrypts back
+TEST_CASE(__FILE__"/Encrypting a string", "[Known answers]") {
+
+  // Setup
+  const Key key = Key::FromPassword("golden");
+
+  // Exercise
+  const std::string ciphertext = GWrapper::EncryptString("Hello, World!", key);
+
+  // Verify
+  REQUIRE(ciphertext ==
+    "6e0ca504fb1997be36893aedad3c428e99644bd03f3ce3912c735a6aeb3ff430"
+    "b21072561c3fa563e0788daab29c9d38f836de70a1b5180317687d3c472bf7f8"
+  );
+  REQUIRE(GWrapper::DecryptString(ciphertext, key) == "Hello, World!");
+}
@@ -0,0 +1,193 @@
+#include <GCrypt/MultiBufferCipher.h>
+#include <GCrypt/GCipher.h>
+#include <GCrypt/Feistel.h>
+#include "Catch2.h"
+
+using namespace Leonetienne::GCrypt;
+
+namespace {
+  // Will digest each stream with its own GCipher
+  std::vector<std::vector<Block>> DigestSeparately(const std::vector<std::vector<Block>>& streams, const std::vector<Key>& keys, const GCipher::DIRECTION direction) {
+    std::vector<std::vector<Block>> results;
+
+    for (std::size_t i = 0; i < streams.size(); i++) {
+      GCipher cipher(keys[i], direction);
+
+      std::vector<Block> result;
+      for (const Block& block : streams[i]) {
+        result.emplace_back(cipher.Digest(block));
+      }
+
+      results.emplace_back(result);
+    }
+
+    return results;
+  }
+
+  // Will digest one stream per lane, all streams of the same length
+  template <std::size_t Lanes>
+  std::vector<std::vector<Block>> DigestInLanes(std::vector<std::vector<Block>> streams, const std::vector<Key>& keys, const GCipher::DIRECTION direction) {
+    MultiBufferCipher<Lanes> cipher(direction);
+    for (std::size_t i = 0; i < Lanes; i++) {
+      cipher.Initialize(i, keys[i]);
+    }
+
+    for (std::size_t b = 0; b < streams[0].size(); b++) {
+      std::array<Block, Lanes> blocks;
+      for (std::size_t i = 0; i < Lanes; i++) {
+        blocks[i] = streams[i][b];
+      }
+
+      cipher.Digest(blocks);
+
+      for (std::size_t i = 0; i < Lanes; i++) {
+        streams[i][b] = blocks[i];
+      }
+    }
+
+    return streams;
+  }
+
+  template <std::size_t Lanes>
+  void RequireLanesEqualGCipher() {
+    std::vector<Key> keys;
+    std::vector<std::vector<Block>> cleartexts;
+    for (std::size_t i = 0; i < Lanes; i++) {
+      keys.emplace_back(Key::Random());
+
+      std::vector<Block> cleartext(20);
+      for (Block& block : cleartext) {
+        block = Key::Random();
+      }
+      cleartexts.emplace_back(cleartext);
+    }
+
+    const std::vector<std::vector<Block>> ciphertexts = DigestInLanes<Lanes>(cleartexts, keys, GCipher::DIRECTION::ENCIPHER);
+    const std::vector<std::vector<Block>> decrypted = DigestInLanes<Lanes>(ciphertexts, keys, GCipher::DIRECTION::DECIPHER);
+
+    REQUIRE(ciphertexts == DigestSeparately(cleartexts, keys, GCipher::DIRECTION::ENCIPHER));
+    REQUIRE(decrypted == cleartexts);
+  }
+}
+
+// Tests that every lane yields exactly what its own GCipher yields, in both directions
+TEST_CASE(__FILE__"/lanes-equal-gcipher", "[MultiBufferCipher]") {
+  // Setup, Exercise, Verify
+  RequireLanesEqualGCipher<4>();
+  RequireLanesEqualGCipher<8>();
+  RequireLanesEqualGCipher<16>();
+}
+
+// Tests that lanes can start and end streams independently, and that released lanes stay untouched
+TEST_CASE(__FILE__"/independent-lanes", "[MultiBufferCipher]") {
+
+  // Setup
+  const Key keyA = Key::Random();
+  const Key keyB = Key::Random();
+  const Block cleartext = Key::Random();
+
+  GCipher referenceA(keyA, GCipher::DIRECTION::ENCIPHER);
+  GCipher referenceB(keyB, GCipher::DIRECTION::ENCIPHER);
+
+  MultiBufferCipher<4> cipher(GCipher::DIRECTION::ENCIPHER);
+  cipher.Initialize(0, keyA);
+
+  // Exercise
+  // Lane 0 runs two blocks, then lane 2 joins, then lane 0 leaves
+  std::array<Block, 4> blocks;
+  blocks.fill(cleartext);
+  cipher.Digest(blocks);
+  const Block a0 = blocks[0];
+  const Block untouched = blocks[1];
+
+  blocks.fill(cleartext);
+  cipher.Initialize(2, keyB);
+  cipher.Digest(blocks);
+  const Block a1 = blocks[0];
+  const Block b0 = blocks[2];
+
+  cipher.Release(0);
+  blocks.fill(cleartext);
+  cipher.Digest(blocks);
+  const Block released = blocks[0];
+  const Block b1 = blocks[2];
+
+  // Verify
+  REQUIRE(a0 == referenceA.Digest(cleartext));
+  REQUIRE(a1 == referenceA.Digest(cleartext));
+  REQUIRE(b0 == referenceB.Digest(cleartext));
+  REQUIRE(b1 == referenceB.Digest(cleartext));
+  REQUIRE(untouched == cleartext);
+  REQUIRE(released == cleartext);
+  REQUIRE_FALSE(cipher.IsActive(0));
+  REQUIRE(cipher.IsActive(2));
+}
+
+// Tests that rolling keysets side by side yields the same keysets as rolling them one by one
+TEST_CASE(__FILE__"/roll-keyset-lanes", "[MultiBufferCipher]") {
+
+  // Setup
+  std::array<Keyset, 4> keysets;
+  std::array<Keyset, 4> expected;
+  std::array<Keyset*, 4> keysetPtrs;
+  for (std::size_t i = 0; i < 4; i++) {
+    Feistel::GenerateKeyset(keysets[i], Key::Random());
+    expected[i] = keysets[i];
+    keysetPtrs[i] = &keysets[i];
+  }
+
+  // Exercise
+  Feistel::RollKeysetLanes<4>(keysetPtrs.data());
+  for (Keyset& keyset : expected) {
+    Feistel::RollKeyset(keyset);
+  }
+
+  // Verify
+  for (std::size_t i = 0; i < 4; i++) {
+    REQUIRE(keysets[i].roundKeys == expected[i].roundKeys);
+    REQUIRE(keysets[i].reducedRoundKeys == expected[i].reducedRoundKeys);
+  }
+}
+
+// Tests that deciphering lanes while rolling the next keysets on the side yields the same blocks,
+// and the same keysets, as deciphering first, and rolling one by one afterwards
+TEST_CASE(__FILE__"/decipher-lanes-and-roll", "[MultiBufferCipher]") {
+
+  // Setup
+  std::array<Keyset, 4> keysets;
+  std::array<Keyset, 4> nextKeysets;
+  std::array<const Keyset*, 4> keysetPtrs;
+  std::array<Keyset*, 4> nextKeysetPtrs;
+  std::array<Block, 4> blocks;
+
+  Feistel::GenerateKeyset(keysets[0], Key::Random());
+  for (std::size_t i = 0; i < 4; i++) {
+    if (i > 0) {
+      keysets[i] = keysets[i - 1];
+      Feistel::RollKeyset(keysets[i]);
+    }
+    keysetPtrs[i] = &keysets[i];
+    nextKeysetPtrs[i] = &nextKeysets[i];
+    blocks[i] = Key::Random();
+  }
+
+  std::array<Block, 4> expectedBlocks = blocks;
+  std::array<Keyset, 4> expectedKeysets;
+
+  // Exercise
+  Feistel::DecipherLanesAndRoll<4>(blocks.data(), keysetPtrs.data(), nextKeysetPtrs.data());
+
+  Feistel::DecipherLanes<4>(expectedBlocks.data(), keysetPtrs.data());
+  Keyset keyset = keysets.back();
+  for (Keyset& expected : expectedKeysets) {
+    Feistel::RollKeyset(keyset);
+    expected = keyset;
+  }
+
+  // Verify
+  REQUIRE(blocks == expectedBlocks);
+  for (std::size_t i = 0; i < 4; i++) {
+    REQUIRE(nextKeysets[i].roundKeys == expectedKeysets[i].roundKeys);
+    REQUIRE(nextKeysets[i].reducedRoundKeys == expectedKeysets[i].reducedRoundKeys);
+  }
+}
@@ -0,0 +1,116 @@
+#include <GCrypt/ParallelDecipher.h>
+#include <GCrypt/ThreadJoiner.h>
+#include <GCrypt/GWrapper.h>
+#include <GCrypt/Key.h>
+#include <GCrypt/Util.h>
+#include "Catch2.h"
+#include "TestUtil.h"
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace Leonetienne::GCrypt;
+
+// Tests that deciphering on multiple threads yields the same as deciphering sequentially,
+// for all kinds of splits into ranges
+TEST_CASE(__FILE__"/same-as-sequential", "[Parallel decipher]") {
+
+  const Key key = Key::Random();
+
+  for (const std::size_t n : { 0, 1, 2, 63, 64, 65, 200, 1000 }) {
+    for (const std::size_t nThreads : { 0, 1, 2, 3, 7, 16 }) {
+      // Setup
+      const std::vector<Block> cleartext = RandomBlocks(n);
+      std::vector<Block> blocks = GWrapper::CipherBlocks(cleartext, key, GCipher::DIRECTION::ENCIPHER);
+
+      // Exercise
+      ParallelDecipher::DecipherInplace(blocks, key, nThreads);
+
+      // Verify
+      REQUIRE(blocks == cleartext);
+    }
+  }
+}
+
+// Tests that a range of at least MIN_BLOCKS_PER_THREAD blocks per thread actually gets split
+TEST_CASE(__FILE__"/many-ranges", "[Parallel decipher]") {
+
+  // Setup
+  const Key key = Key::Random();
+  const std::vector<Block> cleartext = RandomBlocks(8 * ParallelDecipher::MIN_BLOCKS_PER_THREAD + 5);
+  std::vector<Block> blocks = GWrapper::CipherBlocks(cleartext, key, GCipher::DIRECTION::ENCIPHER);
+
+  // Exercise
+  ParallelDecipher::DecipherInplace(blocks.data(), blocks.size(), key, 8);
+
+  // Verify
+  REQUIRE(blocks == cleartext);
+}
+
+// Tests that seeding the ranges from a checkpoint index yields the same as deciphering sequentially
+TEST_CASE(__FILE__"/from-checkpoint-index", "[Parallel decipher]") {
+
+  const Key key = Key::Random();
+
+  for (const std::size_t n : { 1, 64, 65, 1000 }) {
+    for (const std::size_t interval : { 1, 16, 100, 5000 }) {
+      const CheckpointIndex index = CheckpointIndex::Build(key, n, interval);
+
+      for (const std::size_t nThreads : { 1, 3, 16 }) {
+        // Setup
+        const std::vector<Block> cleartext = RandomBlocks(n);
+        std::vector<Block> blocks = GWrapper::CipherBlocks(cleartext, key, GCipher::DIRECTION::ENCIPHER);
+
+        // Exercise
+        ParallelDecipher::DecipherInplace(blocks, key, index, nThreads);
+
+        // Verify
+        REQUIRE(blocks == cleartext);
+      }
+    }
+  }
+}
+
+// Tests that the wrapper decrypts an indexed file just like one without index
+TEST_CASE(__FILE__"/wrapper-with-index", "[Parallel decipher]") {
+
+  // Setup
+  const Key key = Key::Random();
+  const std::string filename_plain = "testAssets/testfile.png";
+  const std::string filename_encrypted = "testAssets/testfile.png.indexed.crypt";
+  const std::string filename_decrypted = "testAssets/testfile.png.indexed.clear.png";
+
+  REQUIRE(GWrapper::EncryptFile(filename_plain, filename_encrypted, key));
+  REQUIRE(GWrapper::IndexFile(filename_encrypted, key, 16));
+
+  // Exercise
+  REQUIRE(GWrapper::DecryptFile(filename_encrypted, filename_decrypted, key));
+
+  // Verify
+  REQUIRE(ReadFileToBlocks(filename_decrypted) == ReadFileToBlocks(filename_plain));
+}
+
+// Tests that workers get joined, and the exception passed on, if the work on the calling thread throws.
+// Otherwise destroying the still joinable workers would call std::terminate().
+TEST_CASE(__FILE__"/joins-workers-on-exception", "[Parallel decipher]") {
+
+  // Setup
+  std::atomic<std::size_t> nFinished { 0 };
+  const auto throwWhileWorkersRun = [&nFinished]() {
+    ThreadJoiner workers;
+    for (std::size_t i = 0; i < 4; i++) {
+      workers.Spawn([&nFinished]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        nFinished++;
+      });
+    }
+
+    throw std::runtime_error("Failed on the calling thread");
+  };
+
+  // Exercise and verify
+  REQUIRE_THROWS_AS(throwWhileWorkersRun(), std::runtime_error);
+  REQUIRE(nFinished == 4);
+}
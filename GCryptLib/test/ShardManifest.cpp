@@ -0,0 +1,58 @@
+#include <GCrypt/ShardManifest.h>
+#include <GCrypt/GWrapper.h>
+#include <GCrypt/Util.h>
+#include "Catch2.h"
+
+using namespace Leonetienne::GCrypt;
+
+// Tests that decrypting all shards, in any order, yields the same file as decrypting it as a whole
+TEST_CASE(__FILE__"/decrypt-all-shards", "[Shard manifest]") {
+
+  // Setup
+  const std::string filename_plain = "testAssets/testfile.png";
+  const std::string filename_encrypted = "testAssets/testfile.png.shard.crypt";
+  const std::string filename_decrypted = "testAssets/testfile.png.shard.clear.png";
+  const std::string filename_manifest = "testAssets/testfile.png.shard.manifest";
+  const Key key = Key::FromPassword("Der Affe will Zucker");
+
+  GWrapper::EncryptFile(filename_plain, filename_encrypted, key);
+  const std::vector<Block> expected = ReadFileToBlocks(filename_plain);
+
+  for (const std::size_t nShards : { 1, 2, 5, 16 }) {
+    // Exercise
+    // (go through a file, like a separate process would)
+    ShardManifest::Plan(filename_encrypted, key, nShards).WriteToFile(filename_manifest);
+    const ShardManifest manifest = ShardManifest::LoadFromFile(filename_manifest);
+
+    manifest.PrepareOutputFile(filename_decrypted);
+    for (std::size_t shard = manifest.GetShardCount(); shard > 0; shard--) {
+      REQUIRE(manifest.DecryptShard(shard - 1, filename_encrypted, filename_decrypted, key));
+    }
+
+    // Verify
+    REQUIRE(manifest.GetShardCount() == nShards);
+    REQUIRE(manifest.GetBlockCount() == expected.size());
+    REQUIRE(ReadFileToBlocks(filename_decrypted) == expected);
+  }
+}
+
+// Tests that the shards cover the whole file, without overlapping
+TEST_CASE(__FILE__"/shards-cover-file", "[Shard manifest]") {
+
+  // Setup
+  const std::string filename_encrypted = "testAssets/testfile.png.shard.crypt";
+  const Key key = Key::FromPassword("Der Affe will Zucker");
+  GWrapper::EncryptFile("testAssets/testfile.png", filename_encrypted, key);
+
+  // Exercise
+  const ShardManifest manifest = ShardManifest::Plan(filename_encrypted, key, 7);
+
+  // Verify
+  std::size_t nextBlock = 0;
+  for (std::size_t shard = 0; shard < manifest.GetShardCount(); shard++) {
+    REQUIRE(manifest.GetShard(shard).firstBlock == nextBlock);
+    REQUIRE(manifest.GetShard(shard).nBlocks > 0);
+    nextBlock += manifest.GetShard(shard).nBlocks;
+  }
+  REQUIRE(nextBlock == manifest.GetBlockCount());
+}
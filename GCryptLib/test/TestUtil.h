@@ -0,0 +1,46 @@
+#ifndef GCRYPTTEST_TESTUTIL_H
+#define GCRYPTTEST_TESTUTIL_H
+
+#include <GCrypt/GCipher.h>
+#include <GCrypt/Key.h>
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+
+//! Will return n random blocks
+inline std::vector<Leonetienne::GCrypt::Block> RandomBlocks(const std::size_t n) {
+  std::vector<Leonetienne::GCrypt::Block> blocks(n);
+  for (Leonetienne::GCrypt::Block& block : blocks) {
+    block = Leonetienne::GCrypt::Key::Random();
+  }
+
+  return blocks;
+}
+
+//! Will return n random bytes
+inline std::string RandomBytes(const std::size_t n) {
+  using Leonetienne::GCrypt::Block;
+
+  std::stringstream ss;
+  for (std::size_t i = 0; i < n; i += Block::BLOCK_SIZE) {
+    const Block block = Leonetienne::GCrypt::Key::Random();
+    ss << block.ToByteString().substr(0, std::min<std::size_t>(Block::BLOCK_SIZE, n - i));
+  }
+
+  return ss.str();
+}
+
+//! Will digest blocks one by one, and return the results
+inline std::vector<Leonetienne::GCrypt::Block> DigestAll(Leonetienne::GCrypt::GCipher& cipher, const std::vector<Leonetienne::GCrypt::Block>& blocks) {
+  std::vector<Leonetienne::GCrypt::Block> digested;
+  digested.reserve(blocks.size());
+
+  for (const Leonetienne::GCrypt::Block& block : blocks) {
+    digested.emplace_back(cipher.Digest(block));
+  }
+
+  return digested;
+}
+
+#endif